@@ -1,6 +1,7 @@
 #include "application.h"
 
 #include <QDebug>
+#include <QImage>
 #include <QTimer>
 #include <QLocale>
 #include <QSysInfo>
@@ -24,6 +25,7 @@ Q_LOGGING_CATEGORY(CATEGORY_APP, "APP")
 Application::Application(int &argc, char **argv):
     QApplication(argc, argv),
     m_updateRegistry(globalPrefs->checkApplicationUpdates() ? QStringLiteral("https://update.flipperzero.one/qFlipper/directory.json") : QString()),
+    m_frameEncoder(ScreenFrameEncoder::Mode::FloydSteinberg, ScreenFrameEncoder::Layout::RowMajor),
     m_isDeveloperMode(QGuiApplication::queryKeyboardModifiers() & Qt::KeyboardModifier::AltModifier),
     m_updateStatus(UpdateStatus::NoUpdates)
 {
@@ -86,6 +88,30 @@ void Application::checkForUpdates()
     m_updateRegistry.check();
 }
 
+bool Application::showImageOnDevice(const QUrl &fileUrl)
+{
+    const QImage image(fileUrl.toLocalFile());
+
+    if(image.isNull()) {
+        qCWarning(CATEGORY_APP).noquote() << "Failed to load image:" << fileUrl.toLocalFile();
+        return false;
+    }
+
+    const auto frame = m_frameEncoder.encode(image);
+
+    if(frame.isEmpty()) {
+        return false;
+    }
+
+    qCDebug(CATEGORY_APP).noquote() << QStringLiteral("Encoded frame #%1 in %2 us, average %3 us")
+                                       .arg(m_frameEncoder.frameCount())
+                                       .arg(m_frameEncoder.lastEncodeTime() / 1000.0, 0, 'f', 1)
+                                       .arg(m_frameEncoder.averageEncodeTime() / 1000.0, 0, 'f', 1);
+
+    m_backend.showVirtualDisplayFrame(frame);
+    return true;
+}
+
 void Application::onLatestVersionChanged()
 {
     if(m_updateRegistry.state() == ApplicationUpdateRegistry::State::Ready && m_updater.canUpdate(m_updateRegistry.latestVersion())) {
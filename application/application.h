@@ -3,6 +3,7 @@
 #include <QApplication>
 #include <QQmlApplicationEngine>
 
+#include "screenframeencoder.h"
 #include "applicationupdater.h"
 #include "applicationbackend.h"
 #include "applicationupdateregistry.h"
@@ -40,6 +41,9 @@ public:
     Q_INVOKABLE void selfUpdate();
     Q_INVOKABLE void checkForUpdates();
 
+    // Dithers an image file down to a single frame and shows it on the device's virtual display
+    Q_INVOKABLE bool showImageOnDevice(const QUrl &fileUrl);
+
 signals:
     void updateStatusChanged();
 
@@ -62,6 +66,7 @@ private:
     ApplicationUpdateRegistry m_updateRegistry;
     ApplicationBackend m_backend;
     QQmlApplicationEngine m_engine;
+    ScreenFrameEncoder m_frameEncoder;
 
     bool m_isDeveloperMode;
     UpdateStatus m_updateStatus;
@@ -12,7 +12,8 @@ SOURCES += \
         applicationupdater.cpp \
         applicationupdateregistry.cpp \
         main.cpp \
-        screencanvas.cpp
+        screencanvas.cpp \
+        screenframeencoder.cpp
 
 RESOURCES += qml.qrc
 
@@ -75,7 +76,8 @@ HEADERS += \
     application.h \
     applicationupdater.h \
     applicationupdateregistry.h \
-    screencanvas.h
+    screencanvas.h \
+    screenframeencoder.h
 
 DISTFILES +=
 
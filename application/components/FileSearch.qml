@@ -0,0 +1,121 @@
+import QtQuick 2.15
+import QtQuick.Layouts 1.15
+import QtQuick.Controls 2.15
+
+import Theme 1.0
+import QFlipper 1.0
+
+ColumnLayout {
+    id: control
+    spacing: 10
+
+    property bool isRefreshing: false
+
+    TransparentLabel {
+        color: Theme.color.lightorange2
+        text: qsTr("Find files")
+    }
+
+    TextField {
+        id: searchField
+        Layout.fillWidth: true
+
+        enabled: refreshAction.enabled
+        selectByMouse: true
+        placeholderText: qsTr("Name or pattern, e.g. *.sub")
+
+        color: Theme.color.lightorange2
+        placeholderTextColor: Theme.color.mediumorange1
+        selectionColor: Theme.color.lightorange2
+        selectedTextColor: Theme.color.darkorange1
+
+        font.pixelSize: 16
+        font.letterSpacing: -1
+        font.family: "Share Tech Mono"
+
+        background: Rectangle {
+            implicitHeight: 34
+            radius: 6
+            color: "black"
+            border.color: searchField.activeFocus ? Theme.color.lightorange2 : Theme.color.mediumorange1
+        }
+
+        // Searches are answered from the local index, so they can run on every keystroke
+        onTextChanged: control.search()
+    }
+
+    ListView {
+        id: resultsView
+        clip: true
+
+        Layout.fillWidth: true
+        Layout.preferredHeight: 150
+
+        ScrollBar.vertical: ScrollBar {}
+
+        delegate: Text {
+            width: resultsView.width
+            elide: Text.ElideMiddle
+
+            color: Theme.color.lightorange2
+            text: modelData
+
+            font.pixelSize: 16
+            font.letterSpacing: -1
+            font.family: "Share Tech Mono"
+        }
+
+        TransparentLabel {
+            anchors.centerIn: parent
+            color: Theme.color.mediumorange1
+            visible: resultsView.count === 0 && searchField.text.length > 0
+            text: control.isRefreshing ? qsTr("Indexing...") : qsTr("No matches")
+        }
+    }
+
+    SmallButton {
+        action: refreshAction
+        Layout.fillWidth: true
+
+        icon.source: "qrc:/assets/gfx/symbolic/update-symbolic.svg"
+        icon.width: 16
+        icon.height: 16
+
+        ToolTip {
+            visible: parent.hovered
+            text: qsTr("Re-read the file list from Flipper. Only changes are transferred after the first time.")
+            implicitWidth: 250
+        }
+    }
+
+    Action {
+        id: refreshAction
+        text: control.isRefreshing ? qsTr("Indexing...") : qsTr("Refresh")
+        enabled: !!Backend.deviceState && !Backend.deviceState.isRecoveryMode
+        onTriggered: control.refresh()
+    }
+
+    Connections {
+        target: Backend
+
+        function onStorageIndexUpdated(success) {
+            control.isRefreshing = false;
+            control.search();
+        }
+
+        function onCurrentDeviceChanged() {
+            resultsView.model = [];
+        }
+    }
+
+    onVisibleChanged: if(visible && refreshAction.enabled) refresh()
+
+    function refresh() {
+        control.isRefreshing = true;
+        Backend.refreshStorageIndex();
+    }
+
+    function search() {
+        resultsView.model = Backend.findFiles(searchField.text);
+    }
+}
@@ -63,6 +63,7 @@ AbstractOverlay {
         items: [
             DeviceInfo { id: deviceInfoPane },
             DeviceActions { id: deviceActions },
+            FileSearch { id: fileSearch },
             DeveloperActions { id: developerActions }
         ]
     }
@@ -95,6 +96,17 @@ AbstractOverlay {
                 visible: parent.hovered
             }
         }
+
+        TabButton {
+            icon.source: "qrc:/assets/gfx/symbolic/search-symbolic.svg"
+            icon.width: 25
+            icon.height: 25
+
+            ToolTip {
+                text: qsTr("Find files")
+                visible: parent.hovered
+            }
+        }
     }
 
     TextLabel {
@@ -33,6 +33,18 @@ AbstractOverlay {
         }
     }
 
+    FileDialog {
+        id: imageDialog
+
+        title: qsTr("Please choose an image")
+        folder: shortcuts.pictures
+        selectExisting: true
+
+        nameFilters: ["Images (*.png *.jpg *.jpeg *.bmp *.gif)"]
+
+        onAccepted: App.showImageOnDevice(fileUrl)
+    }
+
     Rectangle {
         id: canvasBg
         anchors.fill: canvas
@@ -83,6 +95,11 @@ AbstractOverlay {
             Layout.fillWidth: true
         }
 
+        Button {
+            action: showImageAction
+            Layout.alignment: Qt.AlignRight
+        }
+
         Button {
             action: saveAction
             Layout.alignment: Qt.AlignRight
@@ -148,6 +165,14 @@ AbstractOverlay {
         onTriggered: fileDialog.open()
     }
 
+    Action {
+        id: showImageAction
+        text: qsTr("Show Image")
+        shortcut: "Ctrl+O"
+        enabled: overlay.enabled
+        onTriggered: imageDialog.open()
+    }
+
     Action {
         id: copyAction
         text: qsTr("Copy to clipboard")
@@ -68,6 +68,20 @@ AbstractOverlay {
         color: Theme.color.lightorange2
     }
 
+    TextLabel {
+        id: etaLabel
+        anchors.top: messageLabel.bottom
+        anchors.topMargin: 8
+        anchors.horizontalCenter: parent.horizontalCenter
+
+        readonly property int eta: !deviceState || deviceState.isError ? -1 : Math.round(deviceState.eta)
+
+        visible: eta >= 0
+        text: eta < 60 ? qsTr("Less than a minute left") : qsTr("About %n minute(s) left", "", Math.ceil(eta / 60))
+        color: Theme.color.lightorange2
+        opacity: 0.7
+    }
+
     MouseArea {
         x: 620
         y: 120
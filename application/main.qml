@@ -1,6 +1,8 @@
 import QtQuick 2.15
 import QtQuick.Window 2.15
 
+import QFlipper 1.0
+
 import "components"
 
 Window {
@@ -19,6 +21,10 @@ Window {
 
     color: "transparent"
 
+    onVisibilityChanged: {
+        Backend.setScreenVisible(visibility !== Window.Minimized && visibility !== Window.Hidden);
+    }
+
     DragHandler {
         onActiveChanged: if(active) { root.startSystemMove(); }
         target: null
@@ -1,6 +1,7 @@
 #include "screencanvas.h"
 
 #include <cmath>
+#include <QWindow>
 #include <QPainter>
 #include <QClipboard>
 #include <QGuiApplication>
@@ -11,31 +12,23 @@ ScreenCanvas::ScreenCanvas(QQuickItem *parent):
     QQuickPaintedItem(parent),
     m_foreground(QColor(0x00, 0x00, 0x00)),
     m_background(QColor(0xFF, 0xFF, 0xFF)),
-    m_canvas(QImage(1, 1, QImage::Format_RGB32))
+    m_canvas(QImage(1, 1, QImage::Format_RGB32)),
+    m_isDirty(false)
 {}
 
 const QByteArray &ScreenCanvas::data() const
 {
-    static QByteArray dummy;
-    return dummy;
+    return m_data;
 }
 
 void ScreenCanvas::setData(const QByteArray &data)
 {
-    if(data.isEmpty()) {
+    if(data.isEmpty() || data == m_data) {
         return;
     }
 
-    for (auto x = 0; x < canvasWidth(); x++) {
-        for (auto y = 0; y < canvasHeight(); y++) {
-            const auto i = y / 8 * canvasWidth() + x;
-            const auto z = y & 7;
-            const auto color = ((data.at(i) & (1 << z))) ? m_foreground : m_background;
-            m_canvas.setPixelColor(x, y, color);
-        }
-    }
-
-    update();
+    m_data = data;
+    invalidateCanvas();
 }
 
 void ScreenCanvas::paint(QPainter *painter)
@@ -81,7 +74,7 @@ void ScreenCanvas::setCanvasWidth(qreal w)
     m_canvas.fill(m_background);
     emit canvasWidthChanged();
 
-    update();
+    invalidateCanvas();
 }
 
 qreal ScreenCanvas::canvasHeight() const
@@ -99,7 +92,7 @@ void ScreenCanvas::setCanvasHeight(qreal h)
     m_canvas.fill(m_background);
     emit canvasHeightChanged();
 
-    update();
+    invalidateCanvas();
 }
 
 qreal ScreenCanvas::renderWidth() const
@@ -125,6 +118,8 @@ void ScreenCanvas::setForegroundColor(const QColor &color)
 
     m_foreground = color;
     emit foregroundColorChanged();
+
+    invalidateCanvas();
 }
 
 const QColor &ScreenCanvas::backgroundColor() const
@@ -140,6 +135,8 @@ void ScreenCanvas::setBackgroundColor(const QColor &color)
 
     m_background = color;
     emit backgroundColorChanged();
+
+    invalidateCanvas();
 }
 
 void ScreenCanvas::saveImage(const QUrl &url, int scale)
@@ -152,6 +149,28 @@ void ScreenCanvas::copyToClipboard(int scale)
     qGuiApp->clipboard()->setImage(canvas(scale));
 }
 
+void ScreenCanvas::itemChange(ItemChange change, const ItemChangeData &value)
+{
+    if(change == ItemSceneChange) {
+        disconnect(m_windowConnection);
+
+        if(value.window) {
+            m_windowConnection = connect(value.window, &QWindow::visibilityChanged, this, [=]() {
+                if(m_isDirty && isExposed()) {
+                    updateCanvas();
+                }
+            });
+        }
+
+    } else if(change == ItemVisibleHasChanged) {
+        if(m_isDirty && isExposed()) {
+            updateCanvas();
+        }
+    }
+
+    QQuickPaintedItem::itemChange(change, value);
+}
+
 void ScreenCanvas::setRenderWidth(qreal w)
 {
     if(qFuzzyCompare(m_renderWidth, w)) {
@@ -180,3 +199,49 @@ void ScreenCanvas::setRenderHeight(qreal h)
     m_renderHeight = h;
     emit renderHeightChanged();
 }
+
+bool ScreenCanvas::isExposed() const
+{
+    const auto *w = window();
+    return isVisible() && w && w->isVisible() && (w->visibility() != QWindow::Minimized);
+}
+
+void ScreenCanvas::invalidateCanvas()
+{
+    m_isDirty = true;
+
+    if(isExposed()) {
+        updateCanvas();
+    }
+}
+
+void ScreenCanvas::updateCanvas()
+{
+    m_isDirty = false;
+
+    const auto w = m_canvas.width();
+    const auto h = m_canvas.height();
+
+    // Each byte holds a column of 8 vertically adjacent pixels
+    if(m_data.size() < w * ((h + 7) / 8)) {
+        update();
+        return;
+    }
+
+    const auto fg = m_foreground.rgb();
+    const auto bg = m_background.rgb();
+    const auto *src = (const uchar*)m_data.constData();
+
+    for(auto y = 0; y < h; ++y) {
+        const auto *page = src + (y / 8) * w;
+        const auto mask = 1 << (y & 7);
+
+        auto *line = (QRgb*)m_canvas.scanLine(y);
+
+        for(auto x = 0; x < w; ++x) {
+            line[x] = (page[x] & mask) ? fg : bg;
+        }
+    }
+
+    update();
+}
@@ -43,6 +43,9 @@ public slots:
     void saveImage(const QUrl &url, int scale = 0);
     void copyToClipboard(int scale = 0);
 
+protected:
+    void itemChange(ItemChange change, const ItemChangeData &value) override;
+
 signals:
     void canvasWidthChanged();
     void canvasHeightChanged();
@@ -59,9 +62,18 @@ private:
 
 const QImage canvas(int scale = 0) const;
 
+    // Frames are only unpacked while they can be seen,
+    // the latest one is picked up when the item becomes visible again
+    bool isExposed() const;
+    void invalidateCanvas();
+    void updateCanvas();
+
     QColor m_foreground;
     QColor m_background;
     QImage m_canvas;
+    QByteArray m_data;
+    bool m_isDirty;
+    QMetaObject::Connection m_windowConnection;
 
     qreal m_renderWidth;
     qreal m_renderHeight;
@@ -0,0 +1,238 @@
+#include "screenframeencoder.h"
+
+#include <cstring>
+#include <QPainter>
+#include <QtEndian>
+#include <QElapsedTimer>
+
+#include "debug.h"
+
+static const uchar BAYER_MATRIX[8][8] = {
+    { 0, 32,  8, 40,  2, 34, 10, 42},
+    {48, 16, 56, 24, 50, 18, 58, 26},
+    {12, 44,  4, 36, 14, 46,  6, 38},
+    {60, 28, 52, 20, 62, 30, 54, 22},
+    { 3, 35, 11, 43,  1, 33,  9, 41},
+    {51, 19, 59, 27, 49, 17, 57, 25},
+    {15, 47,  7, 39, 13, 45,  5, 37},
+    {63, 31, 55, 23, 61, 29, 53, 21}
+};
+
+// Gathers the least significant bits of all 8 bytes into the top byte, byte 0 ending up in bit 56
+static constexpr quint64 GATHER_MAGIC = 0x0102040810204080ULL;
+
+ScreenFrameEncoder::ScreenFrameEncoder(Mode mode, Layout layout):
+    m_mode(mode),
+    m_layout(layout),
+    m_threshold(-1),
+    m_lastEncodeTime(0),
+    m_totalEncodeTime(0),
+    m_frameCount(0)
+{
+    setThreshold(128);
+}
+
+ScreenFrameEncoder::Mode ScreenFrameEncoder::mode() const
+{
+    return m_mode;
+}
+
+void ScreenFrameEncoder::setMode(Mode mode)
+{
+    m_mode = mode;
+}
+
+ScreenFrameEncoder::Layout ScreenFrameEncoder::layout() const
+{
+    return m_layout;
+}
+
+void ScreenFrameEncoder::setLayout(Layout layout)
+{
+    m_layout = layout;
+}
+
+int ScreenFrameEncoder::threshold() const
+{
+    return m_threshold;
+}
+
+void ScreenFrameEncoder::setThreshold(int threshold)
+{
+    threshold = qBound(0, threshold, 256);
+
+    if(threshold == m_threshold) {
+        return;
+    }
+
+    m_threshold = threshold;
+
+    // Dark pixels are drawn, light ones are not
+    for(auto i = 0; i < 256; ++i) {
+        m_thresholdLut[i] = (i < m_threshold) ? 1 : 0;
+    }
+}
+
+const QByteArray ScreenFrameEncoder::encode(const QImage &image)
+{
+    QElapsedTimer timer;
+    timer.start();
+
+    check_return_val(loadGrayscale(image), QStringLiteral("Failed to convert the image to grayscale"), QByteArray());
+
+    if(m_mode == Mode::OrderedDither) {
+        quantizeOrdered();
+    } else if(m_mode == Mode::FloydSteinberg) {
+        quantizeFloydSteinberg();
+    } else {
+        quantizeThreshold();
+    }
+
+    QByteArray ret(FrameSize, Qt::Uninitialized);
+    auto *out = (uchar*)ret.data();
+
+    if(m_layout == Layout::PageOrdered) {
+        packPageOrdered(out);
+    } else {
+        packRowMajor(out);
+    }
+
+    m_lastEncodeTime = timer.nsecsElapsed();
+    m_totalEncodeTime += m_lastEncodeTime;
+    ++m_frameCount;
+
+    return ret;
+}
+
+qint64 ScreenFrameEncoder::lastEncodeTime() const
+{
+    return m_lastEncodeTime;
+}
+
+qint64 ScreenFrameEncoder::averageEncodeTime() const
+{
+    return m_frameCount ? m_totalEncodeTime / (qint64)m_frameCount : 0;
+}
+
+quint64 ScreenFrameEncoder::frameCount() const
+{
+    return m_frameCount;
+}
+
+bool ScreenFrameEncoder::loadGrayscale(const QImage &image)
+{
+    if(image.isNull()) {
+        return false;
+    }
+
+    QImage gray;
+
+    if(image.size() == QSize(FrameWidth, FrameHeight)) {
+        gray = (image.format() == QImage::Format_Grayscale8) ? image : image.convertToFormat(QImage::Format_Grayscale8);
+
+    } else {
+        // Letterbox the source image onto a white frame, keeping its aspect ratio
+        QImage frame(FrameWidth, FrameHeight, QImage::Format_RGB32);
+        frame.fill(Qt::white);
+
+        const auto scaled = image.scaled(FrameWidth, FrameHeight, Qt::KeepAspectRatio, Qt::SmoothTransformation);
+
+        QPainter painter(&frame);
+        painter.drawImage((FrameWidth - scaled.width()) / 2, (FrameHeight - scaled.height()) / 2, scaled);
+        painter.end();
+
+        gray = frame.convertToFormat(QImage::Format_Grayscale8);
+    }
+
+    if(gray.isNull()) {
+        return false;
+    }
+
+    for(auto y = 0; y < FrameHeight; ++y) {
+        std::memcpy(m_gray + y * FrameWidth, gray.constScanLine(y), FrameWidth);
+    }
+
+    return true;
+}
+
+void ScreenFrameEncoder::quantizeThreshold()
+{
+    for(auto i = 0; i < FrameWidth * FrameHeight; ++i) {
+        m_bits[i] = m_thresholdLut[m_gray[i]];
+    }
+}
+
+void ScreenFrameEncoder::quantizeOrdered()
+{
+    // Centre the matrix around the threshold, so that 128 gives an even 0..255 spread
+    const auto bias = m_threshold - 128;
+
+    for(auto y = 0; y < FrameHeight; ++y) {
+        const auto *row = BAYER_MATRIX[y & 7];
+        const auto *src = m_gray + y * FrameWidth;
+        auto *dst = m_bits + y * FrameWidth;
+
+        for(auto x = 0; x < FrameWidth; ++x) {
+            const auto level = row[x & 7] * 4 + 2 + bias;
+            dst[x] = (src[x] < level) ? 1 : 0;
+        }
+    }
+}
+
+void ScreenFrameEncoder::quantizeFloydSteinberg()
+{
+    // One spare element on each side spares the bounds checks
+    int errors[2][FrameWidth + 2] = {};
+
+    for(auto y = 0; y < FrameHeight; ++y) {
+        auto *current = errors[y & 1];
+        auto *next = errors[(y + 1) & 1];
+
+        std::memset(next, 0, sizeof(errors[0]));
+
+        const auto *src = m_gray + y * FrameWidth;
+        auto *dst = m_bits + y * FrameWidth;
+
+        for(auto x = 0; x < FrameWidth; ++x) {
+            const auto value = src[x] + current[x + 1] / 16;
+            const auto isDark = value < m_threshold;
+            const auto error = value - (isDark ? 0 : 255);
+
+            dst[x] = isDark ? 1 : 0;
+
+            current[x + 2] += error * 7;
+            next[x] += error * 3;
+            next[x + 1] += error * 5;
+            next[x + 2] += error;
+        }
+    }
+}
+
+void ScreenFrameEncoder::packRowMajor(uchar *out) const
+{
+    // Each output byte holds 8 horizontal pixels, leftmost pixel in the LSB
+    for(auto i = 0; i < FrameSize; ++i) {
+        const auto v = qFromLittleEndian<quint64>(m_bits + i * 8);
+        out[i] = (uchar)((v * GATHER_MAGIC) >> 56);
+    }
+}
+
+void ScreenFrameEncoder::packPageOrdered(uchar *out) const
+{
+    // Each output byte holds 8 vertical pixels, topmost pixel in the LSB.
+    // Every byte of m_bits is either 0 or 1, so 8 shifted rows can be summed without carries.
+    for(auto page = 0; page < FrameHeight / 8; ++page) {
+        const auto *src = m_bits + page * 8 * FrameWidth;
+        auto *dst = out + page * FrameWidth;
+
+        for(auto x = 0; x < FrameWidth; x += 8) {
+            quint64 acc = 0;
+
+            for(auto k = 0; k < 8; ++k) {
+                acc |= qFromLittleEndian<quint64>(src + k * FrameWidth + x) << k;
+            }
+
+            qToLittleEndian<quint64>(acc, dst + x);
+        }
+    }
+}
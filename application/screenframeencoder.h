@@ -0,0 +1,63 @@
+#pragma once
+
+#include <QImage>
+#include <QByteArray>
+
+class ScreenFrameEncoder
+{
+public:
+    enum class Mode {
+        Threshold,
+        OrderedDither,
+        FloydSteinberg
+    };
+
+    enum class Layout {
+        RowMajor,   //< XBM-style rows, LSB is the leftmost pixel (VirtualDisplay frames)
+        PageOrdered //< 8-pixel vertical pages, LSB is the topmost pixel (ScreenStreamer frames)
+    };
+
+    static constexpr int FrameWidth = 128;
+    static constexpr int FrameHeight = 64;
+    static constexpr int FrameSize = FrameWidth * FrameHeight / 8;
+
+    ScreenFrameEncoder(Mode mode = Mode::Threshold, Layout layout = Layout::RowMajor);
+
+    Mode mode() const;
+    void setMode(Mode mode);
+
+    Layout layout() const;
+    void setLayout(Layout layout);
+
+    int threshold() const;
+    void setThreshold(int threshold);
+
+    const QByteArray encode(const QImage &image);
+
+    // Per-frame timing, in nanoseconds
+    qint64 lastEncodeTime() const;
+    qint64 averageEncodeTime() const;
+    quint64 frameCount() const;
+
+private:
+    bool loadGrayscale(const QImage &image);
+
+    void quantizeThreshold();
+    void quantizeOrdered();
+    void quantizeFloydSteinberg();
+
+    void packRowMajor(uchar *out) const;
+    void packPageOrdered(uchar *out) const;
+
+    Mode m_mode;
+    Layout m_layout;
+    int m_threshold;
+
+    uchar m_thresholdLut[256];
+    uchar m_gray[FrameWidth * FrameHeight];
+    uchar m_bits[FrameWidth * FrameHeight];
+
+    qint64 m_lastEncodeTime;
+    qint64 m_totalEncodeTime;
+    quint64 m_frameCount;
+};
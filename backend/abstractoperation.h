@@ -38,7 +38,7 @@ protected slots:
     void stopTimeout();
 
 protected:
-    void setOperationState(int state);
+    virtual void setOperationState(int state);
     void finishWithError(BackendError::ErrorType error, const QString &errorString);
 private:
     QTimer *m_timeoutTimer;
@@ -5,6 +5,7 @@
 #include <QLoggingCategory>
 
 #include "abstractoperation.h"
+#include "allocationtracker.h"
 
 Q_LOGGING_CATEGORY(CATEGORY_DEFAULT, "DEFAULT")
 
@@ -52,6 +53,8 @@ void AbstractOperationRunner::processQueue()
 
     auto *operation = m_queue.dequeue();
     qCInfo(loggingCategory()).noquote() << operation->description() << "START";
+
+    ALLOCATION_SCOPE(operation->metaObject()->className(), "Start");
     operation->start();
 }
 
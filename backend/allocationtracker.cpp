@@ -0,0 +1,257 @@
+#include "allocationtracker.h"
+
+#ifdef ALLOCATION_ACCOUNTING
+
+#include <new>
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+#include <algorithm>
+
+#include <QVector>
+#include <QLoggingCategory>
+
+Q_LOGGING_CATEGORY(LOG_ALLOC, "ALLOC")
+
+/* Nothing in here may allocate, except for report().
+ * The table is fixed-size and never rehashed, entries are claimed under a spinlock
+ * (only when entering a scope) and updated with relaxed atomics. */
+
+static constexpr int TABLE_SIZE = 512;
+
+struct AllocationTracker::Entry {
+    std::atomic<const char*> label;
+    const char *stage;
+    std::atomic<quint64> calls;
+    std::atomic<quint64> count;
+    std::atomic<quint64> bytes;
+};
+
+static AllocationTracker::Entry entries[TABLE_SIZE];
+static AllocationTracker::Entry overflowEntry;
+static std::atomic_flag tableLock = ATOMIC_FLAG_INIT;
+
+static std::atomic<quint64> totalCount(0);
+static std::atomic<quint64> totalBytes(0);
+
+static thread_local AllocationTracker::Entry *currentEntry = nullptr;
+
+static AllocationTracker::Entry *findEntry(const char *label, const char *stage)
+{
+    const auto hash = (quintptr)label * 31 + (quintptr)stage;
+
+    while(tableLock.test_and_set(std::memory_order_acquire)) {}
+
+    AllocationTracker::Entry *ret = &overflowEntry;
+
+    for(auto i = 0; i < TABLE_SIZE; ++i) {
+        auto &entry = entries[(hash + i) % TABLE_SIZE];
+        const auto *entryLabel = entry.label.load(std::memory_order_relaxed);
+
+        if(!entryLabel) {
+            entry.stage = stage;
+            entry.label.store(label, std::memory_order_release);
+            ret = &entry;
+            break;
+
+        } else if(entryLabel == label && entry.stage == stage) {
+            ret = &entry;
+            break;
+        }
+    }
+
+    tableLock.clear(std::memory_order_release);
+    return ret;
+}
+
+AllocationTracker::Scope::Scope(const char *label, const char *stage):
+    m_entry(findEntry(label, stage)),
+    m_previous(currentEntry)
+{
+    m_entry->calls.fetch_add(1, std::memory_order_relaxed);
+    currentEntry = m_entry;
+}
+
+AllocationTracker::Scope::~Scope()
+{
+    currentEntry = m_previous;
+}
+
+void AllocationTracker::record(size_t size)
+{
+    totalCount.fetch_add(1, std::memory_order_relaxed);
+    totalBytes.fetch_add(size, std::memory_order_relaxed);
+
+    auto *entry = currentEntry;
+
+    if(entry) {
+        entry->count.fetch_add(1, std::memory_order_relaxed);
+        entry->bytes.fetch_add(size, std::memory_order_relaxed);
+    }
+}
+
+void AllocationTracker::report()
+{
+    struct Row {
+        QByteArray label;
+        const char *stage;
+        quint64 calls;
+        quint64 count;
+        quint64 bytes;
+    };
+
+    // Do not count our own allocations
+    auto *previous = currentEntry;
+    currentEntry = nullptr;
+
+    QVector<Row> rows;
+
+    for(const auto &entry : entries) {
+        const auto *label = entry.label.load(std::memory_order_acquire);
+
+        if(label && entry.count) {
+            rows.append({QByteArray(label), entry.stage, entry.calls, entry.count, entry.bytes});
+        }
+    }
+
+    if(overflowEntry.count) {
+        rows.append({QByteArrayLiteral("(table full)"), "", overflowEntry.calls, overflowEntry.count, overflowEntry.bytes});
+    }
+
+    std::sort(rows.begin(), rows.end(), [](const Row &a, const Row &b) {
+        return a.bytes > b.bytes;
+    });
+
+    qCInfo(LOG_ALLOC).noquote() << QStringLiteral("Total: %1 allocations, %2 bytes").arg(totalCount.load()).arg(totalBytes.load());
+    qCInfo(LOG_ALLOC).noquote() << QStringLiteral("%1 %2 %3 %4 %5 %6").arg(QStringLiteral("Operation"), -40).arg(QStringLiteral("Stage"), -18)
+                                   .arg(QStringLiteral("Calls"), 10).arg(QStringLiteral("Allocs"), 12).arg(QStringLiteral("Bytes"), 14).arg(QStringLiteral("Bytes/call"), 12);
+
+    for(const auto &row : qAsConst(rows)) {
+        qCInfo(LOG_ALLOC).noquote() << QStringLiteral("%1 %2 %3 %4 %5 %6").arg(QString::fromLatin1(row.label), -40).arg(QString::fromLatin1(row.stage), -18)
+                                       .arg(row.calls, 10).arg(row.count, 12).arg(row.bytes, 14).arg(row.calls ? row.bytes / row.calls : 0, 12);
+    }
+
+    currentEntry = previous;
+}
+
+void AllocationTracker::reset()
+{
+    for(auto &entry : entries) {
+        entry.calls = 0;
+        entry.count = 0;
+        entry.bytes = 0;
+    }
+
+    overflowEntry.calls = 0;
+    overflowEntry.count = 0;
+    overflowEntry.bytes = 0;
+
+    totalCount = 0;
+    totalBytes = 0;
+}
+
+#if defined(__GLIBC__)
+
+#include <malloc.h>
+
+/* With glibc, hook malloc itself: QByteArray and QString data is allocated with malloc()
+ * and would be missed by operator new. The default operator new ends up here as well. */
+
+extern "C" {
+
+void *__libc_malloc(size_t size);
+void *__libc_calloc(size_t num, size_t size);
+void *__libc_realloc(void *ptr, size_t size);
+
+void *malloc(size_t size)
+{
+    AllocationTracker::record(size);
+    return __libc_malloc(size);
+}
+
+void *calloc(size_t num, size_t size)
+{
+    AllocationTracker::record(num * size);
+    return __libc_calloc(num, size);
+}
+
+// Only the growth is counted, so that appending to a QByteArray is not charged for the whole buffer
+// every time. The old usable size may exceed the size requested back then, slightly understating growth.
+void *realloc(void *ptr, size_t size)
+{
+    const auto oldSize = ptr ? malloc_usable_size(ptr) : 0;
+
+    if(size > oldSize) {
+        AllocationTracker::record(size - oldSize);
+    }
+
+    return __libc_realloc(ptr, size);
+}
+
+}
+
+#else
+
+/* Elsewhere only operator new can be replaced portably, so QByteArray and QString
+ * buffers are not counted. */
+
+void *operator new(std::size_t size)
+{
+    AllocationTracker::record(size);
+
+    if(auto *ptr = std::malloc(size ? size : 1)) {
+        return ptr;
+    }
+
+    throw std::bad_alloc();
+}
+
+void *operator new[](std::size_t size)
+{
+    return operator new(size);
+}
+
+void *operator new(std::size_t size, const std::nothrow_t &) noexcept
+{
+    AllocationTracker::record(size);
+    return std::malloc(size ? size : 1);
+}
+
+void *operator new[](std::size_t size, const std::nothrow_t &tag) noexcept
+{
+    return operator new(size, tag);
+}
+
+void operator delete(void *ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete[](void *ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete(void *ptr, std::size_t) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete[](void *ptr, std::size_t) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete(void *ptr, const std::nothrow_t &) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete[](void *ptr, const std::nothrow_t &) noexcept
+{
+    std::free(ptr);
+}
+
+#endif
+
+#endif
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <QtGlobal>
+
+/* Opt-in heap accounting, enabled with `qmake CONFIG+=alloc_accounting`.
+ *
+ * Every heap allocation made while a Scope is alive on the current thread is counted
+ * against the (label, stage) pair of the innermost Scope. Labels are usually operation
+ * class names, so the report shows the cost of each operation type.
+ *
+ * Label and stage must point to static strings, as they are compared by address. */
+
+#ifdef ALLOCATION_ACCOUNTING
+#define ALLOCATION_SCOPE(label, stage) const AllocationTracker::Scope allocationScope(label, stage)
+#else
+#define ALLOCATION_SCOPE(label, stage) do {} while(0)
+#endif
+
+class AllocationTracker
+{
+public:
+    struct Entry;
+
+    class Scope
+    {
+    public:
+        Scope(const char *label, const char *stage);
+        ~Scope();
+
+    private:
+        Q_DISABLE_COPY(Scope)
+
+        Entry *m_entry;
+        Entry *m_previous;
+    };
+
+    static void record(size_t size);
+
+    // Prints the totals to the log, largest first
+    static void report();
+    static void reset();
+};
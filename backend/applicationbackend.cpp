@@ -1,14 +1,18 @@
 #include "applicationbackend.h"
 
+#include <QTimer>
 #include <QDebug>
 #include <QLoggingCategory>
 #include <QCoreApplication>
 
 #include "logger.h"
+#include "allocationtracker.h"
 #include "deviceregistry.h"
+#include "backupscheduler.h"
 #include "firmwareupdateregistry.h"
 
 #include "preferences.h"
+#include "storageindex.h"
 #include "flipperupdates.h"
 
 #include "flipperzero/flipperzero.h"
@@ -20,6 +24,8 @@
 
 Q_LOGGING_CATEGORY(LOG_BACKEND, "BACKEND")
 
+#define SCREEN_HIDDEN_GRACE_PERIOD_MS 10000
+
 using namespace Flipper;
 using namespace Zero;
 
@@ -27,14 +33,22 @@ ApplicationBackend::ApplicationBackend(QObject *parent):
     QObject(parent),
     m_deviceRegistry(new DeviceRegistry(this)),
     m_firmwareUpdateRegistry(new FirmwareUpdateRegistry("https://update.flipperzero.one/firmware/directory.json", this)),
+    m_backupScheduler(new BackupScheduler(m_deviceRegistry, this)),
+    m_screenHiddenTimer(new QTimer(this)),
     m_backendState(BackendState::WaitingForDevices),
-    m_errorType(BackendError::UnknownError)
+    m_errorType(BackendError::UnknownError),
+    m_isScreenVisible(true)
 {
+    m_screenHiddenTimer->setSingleShot(true);
+    m_screenHiddenTimer->setInterval(SCREEN_HIDDEN_GRACE_PERIOD_MS);
+
     registerMetaTypes();
     registerComparators();
 
     initLibraryPaths();
     initConnections();
+
+    onBackgroundBackupPreferencesChanged();
 }
 
 ApplicationBackend::BackendState ApplicationBackend::backendState() const
@@ -133,6 +147,19 @@ void ApplicationBackend::factoryReset()
     device()->factoryReset();
 }
 
+void ApplicationBackend::provisionStorage(const QUrl &sourceUrl)
+{
+    setBackendState(BackendState::ProvisioningStorage);
+    device()->provisionStorage(sourceUrl);
+}
+
+void ApplicationBackend::compileBundle(const QUrl &sourceUrl, const QUrl &bundleUrl)
+{
+    if(device()) {
+        device()->compileBundle(sourceUrl, bundleUrl);
+    }
+}
+
 void ApplicationBackend::installFirmware(const QUrl &fileUrl)
 {
     setBackendState(BackendState::InstallingFirmware);
@@ -158,6 +185,10 @@ void ApplicationBackend::startFullScreenStreaming()
 
 void ApplicationBackend::stopFullScreenStreaming()
 {
+    if(device()) {
+        device()->stopVirtualDisplay();
+    }
+
     setBackendState(BackendState::Ready);
 }
 
@@ -168,6 +199,63 @@ void ApplicationBackend::sendInputEvent(int key, int type)
     }
 }
 
+void ApplicationBackend::showVirtualDisplayFrame(const QByteArray &screenFrame)
+{
+    if(device()) {
+        device()->showVirtualDisplayFrame(screenFrame);
+    }
+}
+
+void ApplicationBackend::setScreenVisible(bool set)
+{
+    if(m_isScreenVisible == set) {
+        return;
+    }
+
+    m_isScreenVisible = set;
+
+    if(m_isScreenVisible) {
+        m_screenHiddenTimer->stop();
+
+        if(device()) {
+            device()->setScreenStreamPaused(false);
+        }
+
+    } else {
+        m_screenHiddenTimer->start();
+    }
+}
+
+void ApplicationBackend::refreshStorageIndex()
+{
+    if(device()) {
+        device()->refreshStorageIndex();
+    }
+}
+
+const QStringList ApplicationBackend::findFiles(const QString &pattern, int maxResults) const
+{
+    QStringList ret;
+
+    if(!device()) {
+        return ret;
+    }
+
+    const auto files = device()->storageIndex()->find(pattern.toUtf8(), maxResults);
+
+    for(const auto &fileInfo : files) {
+        ret.append(QString::fromUtf8(fileInfo.absolutePath));
+    }
+
+    return ret;
+}
+
+void ApplicationBackend::runBackgroundBackup(const QUrl &directoryUrl)
+{
+    m_backupScheduler->setBackupPath(directoryUrl.toLocalFile());
+    m_backupScheduler->runNow();
+}
+
 void ApplicationBackend::checkFirmwareUpdates()
 {
     m_firmwareUpdateRegistry->check();
@@ -204,6 +292,12 @@ void ApplicationBackend::onCurrentDeviceChanged()
         // No need to disconnect the old device, as it has been destroyed at this point
         connect(device(), &FlipperZero::operationFinished, this, &ApplicationBackend::onDeviceOperationFinished);
         connect(device(), &FlipperZero::deviceStateChanged, this, &ApplicationBackend::firmwareUpdateStateChanged);
+        connect(device(), &FlipperZero::storageIndexUpdated, this, &ApplicationBackend::storageIndexUpdated);
+        connect(device(), &FlipperZero::bundleCompiled, this, &ApplicationBackend::bundleCompiled);
+
+        if(!m_isScreenVisible) {
+            m_screenHiddenTimer->start();
+        }
 
         waitForDeviceReady();
 
@@ -252,6 +346,22 @@ void ApplicationBackend::onDeviceRegistryErrorChanged()
     }
 }
 
+void ApplicationBackend::onBackgroundBackupPreferencesChanged()
+{
+    const auto &backupPath = globalPrefs->backgroundBackupPath();
+
+    m_backupScheduler->setBackupPath(backupPath);
+    m_backupScheduler->setInterval(backupPath.isEmpty() ? 0 : globalPrefs->backgroundBackupInterval());
+}
+
+void ApplicationBackend::onScreenHiddenTimeout()
+{
+    if(device() && !deviceState()->isRecoveryMode()) {
+        qCDebug(LOG_BACKEND) << "Screen is not visible, pausing screen streaming";
+        device()->setScreenStreamPaused(true);
+    }
+}
+
 void ApplicationBackend::initLibraryPaths()
 {
     const auto appPath = qApp->applicationDirPath();
@@ -273,6 +383,16 @@ void ApplicationBackend::initConnections()
     connect(m_firmwareUpdateRegistry, &UpdateRegistry::latestVersionChanged, this, &ApplicationBackend::firmwareUpdateStateChanged);
 
     connect(m_deviceRegistry, &DeviceRegistry::errorChanged, this, &ApplicationBackend::onDeviceRegistryErrorChanged);
+
+    connect(m_backupScheduler, &BackupScheduler::runFinished, this, &ApplicationBackend::backgroundBackupFinished);
+    connect(globalPrefs, &Preferences::backgroundBackupPathChanged, this, &ApplicationBackend::onBackgroundBackupPreferencesChanged);
+    connect(globalPrefs, &Preferences::backgroundBackupIntervalChanged, this, &ApplicationBackend::onBackgroundBackupPreferencesChanged);
+
+    connect(m_screenHiddenTimer, &QTimer::timeout, this, &ApplicationBackend::onScreenHiddenTimeout);
+
+#ifdef ALLOCATION_ACCOUNTING
+    connect(qApp, &QCoreApplication::aboutToQuit, this, &AllocationTracker::report);
+#endif
 }
 
 void ApplicationBackend::setBackendState(BackendState newState)
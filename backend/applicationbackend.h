@@ -1,16 +1,19 @@
 #pragma once
 
 #include <QObject>
+#include <QStringList>
 
 #include "backenderror.h"
 #include "flipperupdates.h"
 
+class QTimer;
 class QAbstractListModel;
 
 namespace Flipper {
 class FlipperZero;
 class DeviceRegistry;
 class UpdateRegistry;
+class BackupScheduler;
 
 namespace Zero {
 class DeviceState;
@@ -61,6 +64,7 @@ public:
         InstallingFirmware,
         InstallingWirelessStack,
         InstallingFUS,
+        ProvisioningStorage,
         Finished,
         ErrorOccured = 0xff
     };
@@ -101,6 +105,8 @@ public:
     Q_INVOKABLE void createBackup(const QUrl &directoryUrl);
     Q_INVOKABLE void restoreBackup(const QUrl &directoryUrl);
     Q_INVOKABLE void factoryReset();
+    Q_INVOKABLE void provisionStorage(const QUrl &sourceUrl);
+    Q_INVOKABLE void compileBundle(const QUrl &sourceUrl, const QUrl &bundleUrl);
 
     Q_INVOKABLE void installFirmware(const QUrl &fileUrl);
     Q_INVOKABLE void installWirelessStack(const QUrl &fileUrl);
@@ -109,6 +115,18 @@ public:
     Q_INVOKABLE void startFullScreenStreaming();
     Q_INVOKABLE void stopFullScreenStreaming();
     Q_INVOKABLE void sendInputEvent(int key, int type);
+    Q_INVOKABLE void showVirtualDisplayFrame(const QByteArray &screenFrame);
+
+    // The device stops streaming after a grace period if the screen is not visible
+    Q_INVOKABLE void setScreenVisible(bool set);
+
+    // Searches are answered from the local index, refresh it first to pick up changes on the device
+    Q_INVOKABLE void refreshStorageIndex();
+    Q_INVOKABLE const QStringList findFiles(const QString &pattern, int maxResults = 100) const;
+
+    // Backs up all connected devices without interrupting them, see BackupScheduler.
+    // Scheduled runs are configured in Preferences.
+    Q_INVOKABLE void runBackgroundBackup(const QUrl &directoryUrl);
 
     Q_INVOKABLE void checkFirmwareUpdates();
     Q_INVOKABLE void finalizeOperation();
@@ -119,12 +137,17 @@ signals:
     void backendStateChanged();
     void firmwareUpdateStateChanged();
     void isQueryInProgressChanged();
+    void storageIndexUpdated(bool success);
+    void bundleCompiled(bool success);
+    void backgroundBackupFinished(const QString &summaryFile);
 
 private slots:
     void onCurrentDeviceChanged();
     void onCurrentDeviceReady();
     void onDeviceOperationFinished();
     void onDeviceRegistryErrorChanged();
+    void onBackgroundBackupPreferencesChanged();
+    void onScreenHiddenTimeout();
 
 private:
     static void initLibraryPaths();
@@ -140,7 +163,10 @@ private:
 
     Flipper::DeviceRegistry *m_deviceRegistry;
     Flipper::UpdateRegistry *m_firmwareUpdateRegistry;
+    Flipper::BackupScheduler *m_backupScheduler;
+    QTimer *m_screenHiddenTimer;
 
     BackendState m_backendState;
     BackendError::ErrorType m_errorType;
+    bool m_isScreenVisible;
 };
@@ -13,7 +13,10 @@ SOURCES += \
     abstractoperationhelper.cpp \
     abstractoperationrunner.cpp \
     abstractserialoperation.cpp \
+    allocationtracker.cpp \
     applicationbackend.cpp \
+    backgroundfilewriter.cpp \
+    backupscheduler.cpp \
     deviceregistry.cpp \
     failable.cpp \
     filenode.cpp \
@@ -43,7 +46,9 @@ SOURCES += \
     flipperzero/rpc/systemrebootoperation.cpp \
     flipperzero/rpc/systemsetdatetimeoperation.cpp \
     flipperzero/rpc/skipmotdoperation.cpp \
+    flipperzero/rpc/preencodedoperation.cpp \
     flipperzero/devicestate.cpp \
+    flipperzero/etaestimator.cpp \
     flipperzero/factoryinfo.cpp \
     flipperzero/flipperzero.cpp \
     flipperzero/helper/deviceinfohelper.cpp \
@@ -62,18 +67,24 @@ SOURCES += \
     flipperzero/recovery/wirelessstackdownloadoperation.cpp \
     flipperzero/recoveryinterface.cpp \
     flipperzero/screenstreamer.cpp \
+    flipperzero/storagebundle.cpp \
     flipperzero/toplevel/abstracttopleveloperation.cpp \
     flipperzero/toplevel/factoryresetoperation.cpp \
     flipperzero/toplevel/firmwareinstalloperation.cpp \
     flipperzero/toplevel/fullrepairoperation.cpp \
     flipperzero/toplevel/fullupdateoperation.cpp \
+    flipperzero/toplevel/provisionoperation.cpp \
     flipperzero/toplevel/settingsbackupoperation.cpp \
     flipperzero/toplevel/settingsrestoreoperation.cpp \
     flipperzero/toplevel/wirelessstackupdateoperation.cpp \
     flipperzero/utility/abstractutilityoperation.cpp \
     flipperzero/utility/assetsdownloadoperation.cpp \
+    flipperzero/utility/backgroundbackupoperation.cpp \
+    flipperzero/utility/bundlecompileoperation.cpp \
+    flipperzero/utility/bundledownloadoperation.cpp \
     flipperzero/utility/factoryresetutiloperation.cpp \
     flipperzero/utility/getfiletreeoperation.cpp \
+    flipperzero/utility/indexstorageoperation.cpp \
     flipperzero/utility/restartoperation.cpp \
     flipperzero/utility/startrecoveryoperation.cpp \
     flipperzero/utility/userbackupoperation.cpp \
@@ -86,6 +97,7 @@ SOURCES += \
     remotefilefetcher.cpp \
     serialfinder.cpp \
     simpleserialoperation.cpp \
+    storageindex.cpp \
     tararchive.cpp \
     tarziparchive.cpp \
     tempdirectories.cpp \
@@ -97,8 +109,11 @@ HEADERS += \
     abstractoperationrunner.h \
     abstractprotobufmessage.h \
     abstractserialoperation.h \
+    allocationtracker.h \
     applicationbackend.h \
     backenderror.h \
+    backgroundfilewriter.h \
+    backupscheduler.h \
     deviceregistry.h \
     failable.h \
     fileinfo.h \
@@ -131,8 +146,10 @@ HEADERS += \
     flipperzero/rpc/systemrebootoperation.h \
     flipperzero/rpc/systemsetdatetimeoperation.h \
     flipperzero/rpc/skipmotdoperation.h \
+    flipperzero/rpc/preencodedoperation.h \
     flipperzero/deviceinfo.h \
     flipperzero/devicestate.h \
+    flipperzero/etaestimator.h \
     flipperzero/factoryinfo.h \
     flipperzero/flipperzero.h \
     flipperzero/helper/deviceinfohelper.h \
@@ -151,18 +168,24 @@ HEADERS += \
     flipperzero/recovery/wirelessstackdownloadoperation.h \
     flipperzero/recoveryinterface.h \
     flipperzero/screenstreamer.h \
+    flipperzero/storagebundle.h \
     flipperzero/toplevel/abstracttopleveloperation.h \
     flipperzero/toplevel/factoryresetoperation.h \
     flipperzero/toplevel/firmwareinstalloperation.h \
     flipperzero/toplevel/fullrepairoperation.h \
     flipperzero/toplevel/fullupdateoperation.h \
+    flipperzero/toplevel/provisionoperation.h \
     flipperzero/toplevel/settingsbackupoperation.h \
     flipperzero/toplevel/settingsrestoreoperation.h \
     flipperzero/toplevel/wirelessstackupdateoperation.h \
     flipperzero/utility/abstractutilityoperation.h \
     flipperzero/utility/assetsdownloadoperation.h \
+    flipperzero/utility/backgroundbackupoperation.h \
+    flipperzero/utility/bundlecompileoperation.h \
+    flipperzero/utility/bundledownloadoperation.h \
     flipperzero/utility/factoryresetutiloperation.h \
     flipperzero/utility/getfiletreeoperation.h \
+    flipperzero/utility/indexstorageoperation.h \
     flipperzero/utility/restartoperation.h \
     flipperzero/utility/startrecoveryoperation.h \
     flipperzero/utility/userbackupoperation.h \
@@ -175,6 +198,7 @@ HEADERS += \
     remotefilefetcher.h \
     serialfinder.h \
     simpleserialoperation.h \
+    storageindex.h \
     tararchive.h \
     tarziparchive.h \
     tempdirectories.h \
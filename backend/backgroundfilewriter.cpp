@@ -0,0 +1,119 @@
+#include "backgroundfilewriter.h"
+
+#include <QDir>
+#include <QFile>
+#include <QThread>
+#include <QFileInfo>
+#include <QRunnable>
+#include <QThreadPool>
+
+#if defined(Q_OS_LINUX)
+#include <unistd.h>
+#include <sys/syscall.h>
+#elif defined(Q_OS_MAC)
+#include <sys/resource.h>
+#elif defined(Q_OS_WINDOWS)
+#include <windows.h>
+#endif
+
+BackgroundFileWriter::BackgroundFileWriter(QObject *parent):
+    QObject(parent),
+    m_pool(new QThreadPool(this)),
+    m_generation(0),
+    m_pendingCount(0),
+    m_isDeleteWhenIdle(false)
+{
+    // One thread is enough, a single disk does not get any faster with more
+    m_pool->setMaxThreadCount(1);
+}
+
+void BackgroundFileWriter::write(const QString &fileName, const QByteArray &data)
+{
+    enqueue(fileName, [=]() {
+        QFile file(fileName);
+
+        if(!QFileInfo(fileName).absoluteDir().mkpath(QStringLiteral("."))) {
+            return false;
+        } else if(!file.open(QIODevice::WriteOnly)) {
+            return false;
+        }
+
+        return file.write(data) == data.size();
+    });
+}
+
+void BackgroundFileWriter::makePath(const QString &dirPath)
+{
+    enqueue(dirPath, [=]() {
+        return QDir().mkpath(dirPath);
+    });
+}
+
+void BackgroundFileWriter::removePath(const QString &dirPath)
+{
+    enqueue(dirPath, [=]() {
+        return QDir(dirPath).removeRecursively();
+    });
+}
+
+void BackgroundFileWriter::cancel()
+{
+    m_generation.fetchAndAddOrdered(1);
+}
+
+void BackgroundFileWriter::deleteWhenIdle()
+{
+    if(!m_pendingCount) {
+        deleteLater();
+    } else {
+        m_isDeleteWhenIdle = true;
+    }
+}
+
+int BackgroundFileWriter::pendingCount() const
+{
+    return m_pendingCount;
+}
+
+void BackgroundFileWriter::enqueue(const QString &fileName, std::function<bool()> job)
+{
+    ++m_pendingCount;
+
+    const auto generation = m_generation.loadAcquire();
+
+    // The writer is kept alive until every job has reported back, see deleteWhenIdle()
+    m_pool->start(QRunnable::create([=]() {
+        lowerThreadPriority();
+
+        const auto success = (generation == m_generation.loadAcquire()) && job();
+
+        QMetaObject::invokeMethod(this, [=]() {
+            --m_pendingCount;
+            emit finished(fileName, success);
+
+            if(m_isDeleteWhenIdle && !m_pendingCount) {
+                deleteLater();
+            }
+        }, Qt::QueuedConnection);
+    }));
+}
+
+void BackgroundFileWriter::lowerThreadPriority()
+{
+    QThread::currentThread()->setPriority(QThread::IdlePriority);
+
+#if defined(Q_OS_LINUX)
+    // No glibc wrapper for ioprio_set(), values from linux/ioprio.h
+    static constexpr int IOPRIO_WHO_PROCESS = 1;
+    static constexpr int IOPRIO_CLASS_IDLE = 3;
+    static constexpr int IOPRIO_CLASS_SHIFT = 13;
+
+    // Thread id 0 refers to the calling thread
+    syscall(SYS_ioprio_set, IOPRIO_WHO_PROCESS, 0, IOPRIO_CLASS_IDLE << IOPRIO_CLASS_SHIFT);
+#elif defined(Q_OS_MAC)
+    setiopolicy_np(IOPOL_TYPE_DISK, IOPOL_SCOPE_THREAD, IOPOL_THROTTLE);
+#elif defined(Q_OS_WINDOWS)
+    // Lowers both CPU and I/O priority of the calling thread
+    SetThreadPriority(GetCurrentThread(), THREAD_MODE_BACKGROUND_BEGIN);
+#endif
+}
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <QObject>
+#include <QAtomicInt>
+#include <QByteArray>
+
+#include <functional>
+
+class QThreadPool;
+
+/* Writes files on a single idle-priority thread.
+ * Where supported, the thread's disk I/O priority is lowered as well,
+ * so that bulk writes do not compete with the rest of the system.
+ *
+ * Jobs run in the order they were queued and each one reports back with finished().
+ * Do not delete a busy writer, as that would block until its thread is done: use deleteWhenIdle(). */
+
+class BackgroundFileWriter : public QObject
+{
+    Q_OBJECT
+
+public:
+    BackgroundFileWriter(QObject *parent = nullptr);
+
+    // Parent directories are created as needed
+    void write(const QString &fileName, const QByteArray &data);
+    void makePath(const QString &dirPath);
+    void removePath(const QString &dirPath);
+
+    // Jobs queued so far are skipped and report failure, later ones run as usual
+    void cancel();
+    // Lets the queued jobs run first, call cancel() beforehand to skip them
+    void deleteWhenIdle();
+
+    int pendingCount() const;
+
+signals:
+    void finished(const QString &fileName, bool success);
+
+private:
+    void enqueue(const QString &fileName, std::function<bool()> job);
+    static void lowerThreadPriority();
+
+    QThreadPool *m_pool;
+    QAtomicInt m_generation;
+    int m_pendingCount;
+    bool m_isDeleteWhenIdle;
+};
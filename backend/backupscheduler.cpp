@@ -0,0 +1,226 @@
+#include "backupscheduler.h"
+
+#include <QFile>
+#include <QSysInfo>
+#include <QJsonArray>
+#include <QJsonObject>
+#include <QJsonDocument>
+#include <QElapsedTimer>
+#include <QLoggingCategory>
+
+#include "deviceregistry.h"
+
+#include "flipperzero/flipperzero.h"
+#include "flipperzero/devicestate.h"
+#include "flipperzero/utility/backgroundbackupoperation.h"
+
+Q_LOGGING_CATEGORY(LOG_BACKUP, "BACKUP")
+
+#define SIGNATURE_FILE_NAME (QStringLiteral("signature"))
+#define SUMMARY_DIR_NAME (QStringLiteral("summaries"))
+#define TIMESTAMP_FORMAT (QStringLiteral("yyyyMMdd-hhmmss"))
+
+using namespace Flipper;
+using namespace Zero;
+
+BackupScheduler::BackupScheduler(DeviceRegistry *registry, QObject *parent):
+    QObject(parent),
+    m_registry(registry),
+    m_timer(new QTimer(this)),
+    m_isRunning(false)
+{
+    connect(m_timer, &QTimer::timeout, this, &BackupScheduler::runNow);
+}
+
+bool BackupScheduler::isRunning() const
+{
+    return m_isRunning;
+}
+
+const QString BackupScheduler::backupPath() const
+{
+    return m_backupDir.path();
+}
+
+void BackupScheduler::setBackupPath(const QString &backupPath)
+{
+    m_backupDir.setPath(backupPath);
+}
+
+void BackupScheduler::setInterval(int minutes)
+{
+    if(minutes > 0) {
+        m_timer->start(minutes * 60 * 1000);
+    } else {
+        m_timer->stop();
+    }
+}
+
+void BackupScheduler::runNow()
+{
+    if(m_isRunning) {
+        qCDebug(LOG_BACKUP) << "Previous run is still in progress, skipping";
+        return;
+
+    } else if(m_backupDir.path().isEmpty() || !m_backupDir.mkpath(QStringLiteral("."))) {
+        qCCritical(LOG_BACKUP).noquote() << "Cannot use backup directory:" << m_backupDir.path();
+        return;
+    }
+
+    m_isRunning = true;
+    emit isRunningChanged();
+
+    m_startTime = QDateTime::currentDateTime();
+    m_results.clear();
+    m_queue.clear();
+
+    for(auto *device : m_registry->devices()) {
+        m_queue.append(device);
+    }
+
+    qCInfo(LOG_BACKUP).noquote() << "Starting background backup of" << m_queue.size() << "device(s)";
+
+    backupNextDevice();
+}
+
+void BackupScheduler::backupNextDevice()
+{
+    if(m_queue.isEmpty()) {
+        finishRun();
+        return;
+    }
+
+    auto *device = m_queue.takeFirst().data();
+
+    if(!device) {
+        // Disconnected while waiting for its turn
+        QTimer::singleShot(0, this, &BackupScheduler::backupNextDevice);
+        return;
+    }
+
+    const auto deviceName = device->deviceState()->name();
+    const auto timestamp = QDateTime::currentDateTime().toString(TIMESTAMP_FORMAT);
+    const auto snapshotPath = m_backupDir.absoluteFilePath(QStringLiteral("%1/%2").arg(deviceName, timestamp));
+
+    // Written to a temporary directory first, so that an interrupted backup is never mistaken for a complete one
+    const auto partialPath = snapshotPath + QStringLiteral(".partial");
+
+    auto *operation = device->backupInBackground(partialPath, readSignature(deviceName));
+
+    if(!operation) {
+        addResult(deviceName, QStringLiteral("unavailable"), QStringLiteral("Device is busy or not in normal mode"));
+        QTimer::singleShot(0, this, &BackupScheduler::backupNextDevice);
+        return;
+    }
+
+    QElapsedTimer elapsed;
+    elapsed.start();
+
+    // The operation is destroyed without finishing if the device goes away.
+    // Either way, it removes the partial snapshot itself once its pending writes are done.
+    connect(operation, &QObject::destroyed, this, [=]() {
+        addResult(deviceName, QStringLiteral("disconnected"));
+        QTimer::singleShot(0, this, &BackupScheduler::backupNextDevice);
+    });
+
+    connect(operation, &AbstractOperation::finished, this, [=]() {
+        disconnect(operation, &QObject::destroyed, this, nullptr);
+
+        if(operation->isError()) {
+            addResult(deviceName, QStringLiteral("failed"), operation->errorString());
+
+        } else if(operation->isSkipped()) {
+            addResult(deviceName, QStringLiteral("unchanged"));
+
+        } else if(!m_backupDir.rename(partialPath, snapshotPath)) {
+            addResult(deviceName, QStringLiteral("failed"), QStringLiteral("Failed to rename the snapshot directory"));
+
+        } else {
+            writeSignature(deviceName, operation->signature());
+            addResult(deviceName, QStringLiteral("backed-up"));
+        }
+
+        auto &result = m_results.last();
+        result.fileCount = operation->fileCount();
+        result.totalSize = operation->totalSize();
+        result.elapsed = elapsed.elapsed();
+
+        QTimer::singleShot(0, this, &BackupScheduler::backupNextDevice);
+    });
+}
+
+void BackupScheduler::finishRun()
+{
+    const auto summaryFile = writeSummary();
+
+    for(const auto &result : qAsConst(m_results)) {
+        qCInfo(LOG_BACKUP).noquote() << result.deviceName << result.status << result.errorString;
+    }
+
+    qCInfo(LOG_BACKUP).noquote() << "Background backup finished, summary saved to" << summaryFile;
+
+    m_isRunning = false;
+    emit isRunningChanged();
+    emit runFinished(summaryFile);
+}
+
+void BackupScheduler::addResult(const QString &deviceName, const QString &status, const QString &errorString)
+{
+    m_results.append({deviceName, status, errorString, 0, 0, 0});
+}
+
+const QString BackupScheduler::writeSummary() const
+{
+    QJsonArray devices;
+
+    for(const auto &result : m_results) {
+        QJsonObject device;
+
+        device.insert(QStringLiteral("name"), result.deviceName);
+        device.insert(QStringLiteral("status"), result.status);
+        device.insert(QStringLiteral("files"), result.fileCount);
+        device.insert(QStringLiteral("bytes"), result.totalSize);
+        device.insert(QStringLiteral("durationMs"), result.elapsed);
+
+        if(!result.errorString.isEmpty()) {
+            device.insert(QStringLiteral("error"), result.errorString);
+        }
+
+        devices.append(device);
+    }
+
+    QJsonObject summary;
+    summary.insert(QStringLiteral("host"), QSysInfo::machineHostName());
+    summary.insert(QStringLiteral("started"), m_startTime.toString(Qt::ISODate));
+    summary.insert(QStringLiteral("finished"), QDateTime::currentDateTime().toString(Qt::ISODate));
+    summary.insert(QStringLiteral("devices"), devices);
+
+    const auto fileName = m_backupDir.absoluteFilePath(QStringLiteral("%1/%2.json").arg(SUMMARY_DIR_NAME, m_startTime.toString(TIMESTAMP_FORMAT)));
+
+    QFile file(fileName);
+
+    if(!m_backupDir.mkpath(SUMMARY_DIR_NAME) || !file.open(QIODevice::WriteOnly)) {
+        qCCritical(LOG_BACKUP).noquote() << "Failed to write backup summary:" << file.errorString();
+        return QString();
+    }
+
+    file.write(QJsonDocument(summary).toJson());
+    return fileName;
+}
+
+const QByteArray BackupScheduler::readSignature(const QString &deviceName) const
+{
+    QFile file(m_backupDir.absoluteFilePath(QStringLiteral("%1/%2").arg(deviceName, SIGNATURE_FILE_NAME)));
+    return file.open(QIODevice::ReadOnly) ? file.readAll().trimmed() : QByteArray();
+}
+
+void BackupScheduler::writeSignature(const QString &deviceName, const QByteArray &signature)
+{
+    QFile file(m_backupDir.absoluteFilePath(QStringLiteral("%1/%2").arg(deviceName, SIGNATURE_FILE_NAME)));
+
+    if(!file.open(QIODevice::WriteOnly)) {
+        qCWarning(LOG_BACKUP).noquote() << "Failed to save tree signature:" << file.errorString();
+    } else {
+        file.write(signature);
+    }
+}
@@ -0,0 +1,75 @@
+#pragma once
+
+#include <QDir>
+#include <QTimer>
+#include <QObject>
+#include <QVector>
+#include <QPointer>
+#include <QDateTime>
+
+namespace Flipper {
+
+class FlipperZero;
+class DeviceRegistry;
+
+/* Periodically backs up the internal storage of every connected device, one device at a time.
+ *
+ * Layout of the backup directory:
+ *   <device name>/<timestamp>/int/...  - one snapshot per backup that found changes
+ *   <device name>/signature            - file tree signature of the latest snapshot
+ *   summaries/<timestamp>.json         - outcome of every run */
+
+class BackupScheduler : public QObject
+{
+    Q_OBJECT
+    Q_PROPERTY(bool isRunning READ isRunning NOTIFY isRunningChanged)
+
+    struct Result {
+        QString deviceName;
+        QString status;
+        QString errorString;
+        int fileCount;
+        qint64 totalSize;
+        qint64 elapsed;
+    };
+
+public:
+    BackupScheduler(DeviceRegistry *registry, QObject *parent = nullptr);
+
+    bool isRunning() const;
+
+    const QString backupPath() const;
+    void setBackupPath(const QString &backupPath);
+
+    // In minutes, 0 disables scheduled runs
+    void setInterval(int minutes);
+
+public slots:
+    void runNow();
+
+signals:
+    void isRunningChanged();
+    void runFinished(const QString &summaryFile);
+
+private slots:
+    void backupNextDevice();
+
+private:
+    void finishRun();
+    void addResult(const QString &deviceName, const QString &status, const QString &errorString = QString());
+
+    const QString writeSummary() const;
+    const QByteArray readSignature(const QString &deviceName) const;
+    void writeSignature(const QString &deviceName, const QByteArray &signature);
+
+    DeviceRegistry *m_registry;
+    QTimer *m_timer;
+    QDir m_backupDir;
+
+    QVector<QPointer<FlipperZero>> m_queue;
+    QVector<Result> m_results;
+    QDateTime m_startTime;
+    bool m_isRunning;
+};
+
+}
@@ -40,6 +40,11 @@ FlipperZero *DeviceRegistry::currentDevice() const
     return m_devices.isEmpty() ? nullptr : m_devices.first();
 }
 
+const DeviceRegistry::DeviceList &DeviceRegistry::devices() const
+{
+    return m_devices;
+}
+
 int DeviceRegistry::deviceCount() const
 {
     return m_devices.size();
@@ -16,12 +16,13 @@ class DeviceRegistry : public QObject
 {
     Q_OBJECT
 
+public:
     using DeviceList = QVector<FlipperZero*>;
 
-public:
     DeviceRegistry(QObject *parent = nullptr);
 
     FlipperZero *currentDevice() const;
+    const DeviceList &devices() const;
     int deviceCount() const;
 
     BackendError::ErrorType error() const;
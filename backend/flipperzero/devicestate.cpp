@@ -16,7 +16,8 @@ DeviceState::DeviceState(const DeviceInfo &deviceInfo, QObject *parent):
     m_isVirtualDisplay(false),
     m_isOnline(false),
     m_error(BackendError::NoError),
-    m_progress(-1.0)
+    m_progress(-1.0),
+    m_eta(-1.0)
 {
     connect(this, &DeviceState::deviceInfoChanged, this, &DeviceState::onDeviceInfoChanged);
     connect(this, &DeviceState::isOnlineChanged, this, &DeviceState::onIsOnlineChanged);
@@ -134,6 +135,21 @@ void DeviceState::setProgress(double newProgress)
     emit progressChanged();
 }
 
+double DeviceState::eta() const
+{
+    return m_eta;
+}
+
+void DeviceState::setEta(double newEta)
+{
+    if(qFuzzyCompare(m_eta, newEta)) {
+        return;
+    }
+
+    m_eta = newEta;
+    emit etaChanged();
+}
+
 const QString &DeviceState::statusString() const
 {
     return m_statusString;
@@ -27,6 +27,7 @@ class DeviceState : public QObject
     Q_PROPERTY(QSize screenSize READ screenSize CONSTANT)
     Q_PROPERTY(QByteArray screenData READ screenData NOTIFY screenDataChanged)
     Q_PROPERTY(double progress READ progress NOTIFY progressChanged)
+    Q_PROPERTY(double eta READ eta NOTIFY etaChanged)
 
 public:
     DeviceState(const DeviceInfo &deviceInfo, QObject *parent = nullptr);
@@ -53,6 +54,10 @@ public:
     double progress() const;
     void setProgress(double newProgress);
 
+    // Estimated remaining time of the current operation in seconds, -1 if unknown
+    double eta() const;
+    void setEta(double newEta);
+
     const QString &statusString() const;
     void setStatusString(const QString &newStatusString);
 
@@ -81,6 +86,7 @@ signals:
     void isErrorChanged();
     void screenDataChanged();
     void progressChanged();
+    void etaChanged();
 
 private slots:
     void onDeviceInfoChanged();
@@ -103,6 +109,7 @@ private:
     QByteArray m_screenData;
 
     double m_progress;
+    double m_eta;
 };
 
 }
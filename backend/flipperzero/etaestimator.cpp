@@ -0,0 +1,240 @@
+#include "etaestimator.h"
+
+#include <QTimer>
+#include <QSysInfo>
+#include <QSettings>
+
+#include "devicestate.h"
+
+#define HISTORY_GROUP_KEY (QStringLiteral("History"))
+#define STAGE_ORDER_KEY (QStringLiteral("StageOrder"))
+#define DURATION_KEY (QStringLiteral("Duration"))
+#define THROUGHPUT_KEY (QStringLiteral("Throughput"))
+
+// Weight of the newest sample in the stored averages
+static constexpr double HISTORY_WEIGHT = 0.5;
+// Weight of the newest prediction in the published value
+static constexpr double SMOOTHING_WEIGHT = 0.3;
+// Progress-based extrapolation is too noisy before that
+static constexpr qint64 MIN_EXTRAPOLATION_TIME_MS = 2000;
+
+using namespace Flipper;
+using namespace Zero;
+
+EtaEstimator::EtaEstimator(const QString &operationName, DeviceState *deviceState, QObject *parent):
+    QObject(parent),
+    m_deviceState(deviceState),
+    m_operationName(operationName),
+    m_deviceName(deviceState->deviceInfo().name),
+    m_timer(new QTimer(this)),
+    m_currentStage(-1),
+    m_workload(-1),
+    m_remainingTime(-1)
+{
+    connect(m_timer, &QTimer::timeout, this, &EtaEstimator::update);
+    m_timer->setInterval(1000);
+
+    loadHistory();
+}
+
+void EtaEstimator::beginStage(int stage)
+{
+    if(stage == m_currentStage) {
+        return;
+    }
+
+    endStage();
+
+    m_currentStage = stage;
+    m_workload = -1;
+    m_stages.append(stage);
+    m_stageTimer.start();
+
+    if(!m_timer->isActive()) {
+        m_updateTimer.start();
+        m_timer->start();
+    }
+
+    update();
+}
+
+void EtaEstimator::setStageWorkload(qint64 bytes)
+{
+    m_workload = bytes;
+    update();
+}
+
+void EtaEstimator::finish(bool success)
+{
+    if(success) {
+        endStage();
+        saveStageOrder();
+    } else {
+        m_currentStage = -1;
+    }
+
+    m_timer->stop();
+    m_remainingTime = -1;
+    m_deviceState->setEta(m_remainingTime);
+}
+
+double EtaEstimator::remainingTime() const
+{
+    return m_remainingTime;
+}
+
+void EtaEstimator::update()
+{
+    const auto predicted = predictRemaining();
+    const auto dt = m_updateTimer.restart() / 1000.0;
+
+    if(m_remainingTime < 0) {
+        m_remainingTime = predicted;
+
+    } else {
+        // Count down between predictions, so that the value keeps moving even with no new information
+        const auto decayed = qMax(m_remainingTime - dt, 0.0);
+        m_remainingTime = (predicted < 0) ? decayed : SMOOTHING_WEIGHT * predicted + (1.0 - SMOOTHING_WEIGHT) * decayed;
+    }
+
+    m_deviceState->setEta(m_remainingTime);
+}
+
+void EtaEstimator::loadHistory()
+{
+    QSettings settings;
+    settings.beginGroup(settingsGroup());
+
+    const auto stageOrder = settings.value(STAGE_ORDER_KEY).toList();
+
+    for(const auto &stage : stageOrder) {
+        m_historyOrder.append(stage.toInt());
+    }
+
+    const auto stageGroups = settings.childGroups();
+
+    for(const auto &stageGroup : stageGroups) {
+        bool canConvert;
+        const auto stage = stageGroup.toInt(&canConvert);
+
+        if(!canConvert) {
+            continue;
+        }
+
+        settings.beginGroup(stageGroup);
+        m_history.insert(stage, {settings.value(DURATION_KEY).toDouble(), settings.value(THROUGHPUT_KEY).toDouble()});
+        settings.endGroup();
+    }
+}
+
+void EtaEstimator::endStage()
+{
+    if(m_currentStage < 0) {
+        return;
+    }
+
+    saveStage(m_currentStage, m_stageTimer.elapsed(), m_workload);
+    m_currentStage = -1;
+}
+
+void EtaEstimator::saveStage(int stage, qint64 elapsed, qint64 workload)
+{
+    const auto throughput = (workload > 0 && elapsed > 0) ? (double)workload / elapsed : 0.0;
+
+    auto it = m_history.find(stage);
+
+    if(it == m_history.end()) {
+        it = m_history.insert(stage, {(double)elapsed, throughput});
+
+    } else {
+        it->duration = HISTORY_WEIGHT * elapsed + (1.0 - HISTORY_WEIGHT) * it->duration;
+
+        if(throughput > 0) {
+            it->throughput = (it->throughput > 0) ? HISTORY_WEIGHT * throughput + (1.0 - HISTORY_WEIGHT) * it->throughput : throughput;
+        }
+    }
+
+    QSettings settings;
+    settings.beginGroup(settingsGroup());
+    settings.beginGroup(QString::number(stage));
+    settings.setValue(DURATION_KEY, it->duration);
+    settings.setValue(THROUGHPUT_KEY, it->throughput);
+}
+
+void EtaEstimator::saveStageOrder()
+{
+    QVariantList stageOrder;
+
+    for(const auto stage : qAsConst(m_stages)) {
+        stageOrder.append(stage);
+    }
+
+    m_historyOrder = m_stages;
+
+    QSettings settings;
+    settings.beginGroup(settingsGroup());
+    settings.setValue(STAGE_ORDER_KEY, stageOrder);
+}
+
+double EtaEstimator::predictStage(int stage, qint64 workload) const
+{
+    const auto it = m_history.constFind(stage);
+
+    if(it == m_history.constEnd()) {
+        return -1;
+    } else if(workload > 0 && it->throughput > 0) {
+        return workload / it->throughput;
+    } else {
+        return it->duration;
+    }
+}
+
+double EtaEstimator::predictRemaining() const
+{
+    auto isKnown = false;
+    auto remaining = 0.0;
+
+    if(m_currentStage >= 0) {
+        const auto elapsed = m_stageTimer.elapsed();
+        const auto progress = m_deviceState->progress();
+        const auto predicted = predictStage(m_currentStage, m_workload);
+
+        const auto fromHistory = (predicted < 0) ? -1.0 : qMax(predicted - elapsed, 0.0);
+        const auto fromProgress = (progress > 0 && progress < 100 && elapsed > MIN_EXTRAPOLATION_TIME_MS) ?
+                                   elapsed * (100.0 - progress) / progress : -1.0;
+
+        if(fromHistory >= 0 && fromProgress >= 0) {
+            remaining += (fromHistory + fromProgress) / 2.0;
+            isKnown = true;
+        } else if(fromHistory >= 0 || fromProgress >= 0) {
+            remaining += qMax(fromHistory, fromProgress);
+            isKnown = true;
+        }
+    }
+
+    // Stages left according to the last successful run
+    const auto currentIndex = m_historyOrder.indexOf(m_currentStage);
+
+    for(auto i = 0; i < m_historyOrder.size(); ++i) {
+        const auto stage = m_historyOrder.at(i);
+        const auto isPending = (currentIndex >= 0) ? (i > currentIndex) : (stage > m_currentStage && !m_stages.contains(stage));
+
+        if(!isPending) {
+            continue;
+        }
+
+        const auto predicted = predictStage(stage, -1);
+
+        if(predicted >= 0) {
+            remaining += predicted;
+            isKnown = true;
+        }
+    }
+
+    return isKnown ? remaining / 1000.0 : -1.0;
+}
+
+const QString EtaEstimator::settingsGroup() const
+{
+    return QStringLiteral("%1/%2/%3/%4").arg(HISTORY_GROUP_KEY, QSysInfo::machineHostName(), m_deviceName, m_operationName);
+}
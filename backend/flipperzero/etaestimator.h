@@ -0,0 +1,76 @@
+#pragma once
+
+#include <QMap>
+#include <QObject>
+#include <QVector>
+#include <QElapsedTimer>
+
+class QTimer;
+
+namespace Flipper {
+namespace Zero {
+
+class DeviceState;
+
+/* Predicts the remaining time of a multi-stage operation.
+ *
+ * Stage durations and throughputs are remembered per host, device and operation type.
+ * The running stage is predicted from its history and the progress reported by the device,
+ * the remaining stages are taken from the last successful run. The smoothed result
+ * is published as DeviceState::eta. */
+
+class EtaEstimator : public QObject
+{
+    Q_OBJECT
+
+    struct StageRecord {
+        double duration;   //< Milliseconds
+        double throughput; //< Bytes per millisecond, 0 if unknown
+    };
+
+public:
+    EtaEstimator(const QString &operationName, DeviceState *deviceState, QObject *parent = nullptr);
+
+    // Ends the previous stage (if any) and starts a new one
+    void beginStage(int stage);
+    // Amount of data to be transferred during the current stage
+    void setStageWorkload(qint64 bytes);
+    // The failed stage is discarded, the stage order is only saved after a successful run
+    void finish(bool success);
+
+    // In seconds, -1 if unknown
+    double remainingTime() const;
+
+private slots:
+    void update();
+
+private:
+    void loadHistory();
+    void endStage();
+    void saveStage(int stage, qint64 elapsed, qint64 workload);
+    void saveStageOrder();
+
+    double predictStage(int stage, qint64 workload) const;
+    double predictRemaining() const;
+
+    const QString settingsGroup() const;
+
+    DeviceState *m_deviceState;
+    QString m_operationName;
+    QString m_deviceName;
+    QTimer *m_timer;
+
+    QMap<int, StageRecord> m_history;
+    QVector<int> m_historyOrder;
+    QVector<int> m_stages;
+
+    int m_currentStage;
+    qint64 m_workload;
+    QElapsedTimer m_stageTimer;
+    QElapsedTimer m_updateTimer;
+
+    double m_remainingTime;
+};
+
+}
+}
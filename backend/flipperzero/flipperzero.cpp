@@ -5,6 +5,7 @@
 #include <QLoggingCategory>
 
 #include "preferences.h"
+#include "storageindex.h"
 #include "flipperupdates.h"
 
 #include "devicestate.h"
@@ -20,9 +21,13 @@
 #include "toplevel/settingsrestoreoperation.h"
 #include "toplevel/settingsbackupoperation.h"
 #include "toplevel/factoryresetoperation.h"
+#include "toplevel/provisionoperation.h"
 #include "toplevel/fullrepairoperation.h"
 #include "toplevel/fullupdateoperation.h"
 
+#include "utility/indexstorageoperation.h"
+#include "utility/backgroundbackupoperation.h"
+
 #include "preferences.h"
 
 #include "pixmaps/updating.h"
@@ -45,7 +50,8 @@ FlipperZero::FlipperZero(const Zero::DeviceInfo &info, QObject *parent):
     m_recovery(new RecoveryInterface(m_state, this)),
     m_utility(new UtilityInterface(m_state, m_rpc, this)),
     m_streamer(new ScreenStreamer(m_state, m_rpc, this)),
-    m_virtualDisplay(new VirtualDisplay(m_state, m_rpc, this))
+    m_virtualDisplay(new VirtualDisplay(m_state, m_rpc, this)),
+    m_isIndexingStorage(false)
 {
     connect(m_state, &DeviceState::deviceInfoChanged, this, &FlipperZero::onDeviceInfoChanged);
     connect(m_state, &DeviceState::deviceInfoChanged, this, &FlipperZero::deviceStateChanged);
@@ -61,6 +67,11 @@ DeviceState *FlipperZero::deviceState() const
     return m_state;
 }
 
+const StorageIndex *FlipperZero::storageIndex() const
+{
+    return &m_storageIndex;
+}
+
 // TODO: Handle -rcxx suffixes correctly
 bool FlipperZero::canUpdate(const Updates::VersionInfo &versionInfo) const
 {
@@ -163,6 +174,67 @@ void FlipperZero::factoryReset()
     registerOperation(new FactoryResetOperation(m_utility, m_state, this));
 }
 
+void FlipperZero::provisionStorage(const QUrl &sourceUrl)
+{
+    registerOperation(new ProvisionOperation(m_utility, m_state, sourceUrl.toLocalFile(), this));
+}
+
+void FlipperZero::compileBundle(const QUrl &sourceUrl, const QUrl &bundleUrl)
+{
+    if(m_state->isRecoveryMode()) {
+        qCWarning(CAT_DEVICE) << "Cannot compile a bundle: protocol version is unknown in recovery mode";
+        emit bundleCompiled(false);
+        return;
+    }
+
+    auto *operation = m_utility->compileBundle(sourceUrl.toLocalFile(), bundleUrl.toLocalFile());
+
+    connect(operation, &AbstractOperation::finished, this, [=]() {
+        if(operation->isError()) {
+            qCCritical(CAT_DEVICE).noquote() << operation->description() << "ERROR:" << operation->errorString();
+        }
+
+        emit bundleCompiled(!operation->isError());
+    });
+}
+
+void FlipperZero::refreshStorageIndex()
+{
+    if(m_state->isRecoveryMode() || !m_rpc->isSessionUp()) {
+        qCWarning(CAT_DEVICE) << "Cannot index storage: RPC session is not running";
+        emit storageIndexUpdated(false);
+        return;
+
+    } else if(m_isIndexingStorage) {
+        qCDebug(CAT_DEVICE) << "Storage index refresh is already in progress";
+        return;
+    }
+
+    m_isIndexingStorage = true;
+
+    auto *operation = m_utility->indexStorage(&m_storageIndex);
+
+    connect(operation, &AbstractOperation::finished, this, [=]() {
+        m_isIndexingStorage = false;
+
+        if(!operation->isError()) {
+            qCDebug(CAT_DEVICE).noquote() << "Storage index contains" << m_storageIndex.size() << "entries";
+        }
+
+        emit storageIndexUpdated(!operation->isError());
+    });
+}
+
+BackgroundBackupOperation *FlipperZero::backupInBackground(const QString &backupPath, const QByteArray &lastSignature)
+{
+    if(m_state->isRecoveryMode() || m_state->isPersistent() || !m_rpc->isSessionUp() || m_backgroundBackup) {
+        return nullptr;
+    }
+
+    m_backgroundBackup = m_utility->backupInBackground(backupPath, lastSignature);
+    return m_backgroundBackup;
+}
+
 void FlipperZero::installFirmware(const QUrl &fileUrl)
 {
     registerOperation(new FirmwareInstallOperation(m_recovery, m_utility, m_state, fileUrl.toLocalFile(), this));
@@ -183,6 +255,28 @@ void FlipperZero::sendInputEvent(int key, int type)
     m_streamer->sendInputEvent(key, type);
 }
 
+void FlipperZero::showVirtualDisplayFrame(const QByteArray &screenFrame)
+{
+    if(m_state->isRecoveryMode() || m_state->isPersistent()) {
+        qCWarning(CAT_DEVICE) << "Cannot show a frame: device is busy";
+        return;
+    }
+
+    m_virtualDisplay->showFrame(screenFrame);
+}
+
+void FlipperZero::stopVirtualDisplay()
+{
+    if(m_state->isVirtualDisplayEnabled()) {
+        m_virtualDisplay->stop();
+    }
+}
+
+void FlipperZero::setScreenStreamPaused(bool set)
+{
+    m_streamer->setPaused(set);
+}
+
 void FlipperZero::finalizeOperation()
 {
     // TODO: write a better implementation that would:
@@ -243,6 +337,11 @@ void FlipperZero::onSessionStatusChanged()
 
 void FlipperZero::registerOperation(AbstractOperation *operation)
 {
+    if(m_backgroundBackup) {
+        qCInfo(CAT_DEVICE).noquote() << "Cancelling background backup in favour of" << operation->description();
+        m_backgroundBackup->cancel();
+    }
+
     connect(operation, &AbstractOperation::finished, this, [=]() {
         if(operation->isError()) {
             qCCritical(CAT_DEVICE).noquote() << operation->description() << "ERROR:" << operation->errorString();
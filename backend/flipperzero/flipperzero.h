@@ -2,6 +2,9 @@
 
 #include <QSize>
 #include <QObject>
+#include <QPointer>
+
+#include "storageindex.h"
 
 class USBDeviceInfo;
 class AbstractOperation;
@@ -19,6 +22,7 @@ namespace Zero {
     class UtilityInterface;
     class ScreenStreamer;
     class VirtualDisplay;
+    class BackgroundBackupOperation;
 }
 
 class FlipperZero : public QObject
@@ -29,6 +33,7 @@ public:
     FlipperZero(const Zero::DeviceInfo &info, QObject *parent = nullptr);
 
     Zero::DeviceState *deviceState() const;
+    const StorageIndex *storageIndex() const;
 
     bool canUpdate(const Flipper::Updates::VersionInfo &versionInfo) const;
     bool canInstall(const Flipper::Updates::VersionInfo &versionInfo) const;
@@ -40,6 +45,18 @@ public:
     void createBackup(const QUrl &directoryUrl);
     void restoreBackup(const QUrl &directoryUrl);
     void factoryReset();
+    void provisionStorage(const QUrl &sourceUrl);
+
+    // Encodes a directory for this device's protocol version without writing anything to it
+    void compileBundle(const QUrl &sourceUrl, const QUrl &bundleUrl);
+
+    // Walks the device storage and brings the local index up to date.
+    // Does not interrupt screen streaming, calls made during a refresh are merged into it.
+    void refreshStorageIndex();
+
+    // Returns nullptr if the device is busy or not in a normal mode.
+    // Cancelled as soon as any interactive operation is requested.
+    Zero::BackgroundBackupOperation *backupInBackground(const QString &backupPath, const QByteArray &lastSignature);
 
     void installFirmware(const QUrl &fileUrl);
     void installWirelessStack(const QUrl &fileUrl);
@@ -48,9 +65,19 @@ public:
     void sendInputEvent(int key, int type);
     void finalizeOperation();
 
+    // Shows a pre-encoded frame (see pixmaps/*.h for the layout) instead of the device's own screen
+    void showVirtualDisplayFrame(const QByteArray &screenFrame);
+    void stopVirtualDisplay();
+
+    // Stops the screen stream on the device while nobody is watching it.
+    // Operations and DeviceState::isStreamingEnabled() are not affected.
+    void setScreenStreamPaused(bool set);
+
 signals:
     void deviceStateChanged();
     void operationFinished();
+    void storageIndexUpdated(bool success);
+    void bundleCompiled(bool success);
 
 private slots:
     void onDeviceInfoChanged();
@@ -65,6 +92,9 @@ private:
     Zero::UtilityInterface *m_utility;
     Zero::ScreenStreamer *m_streamer;
     Zero::VirtualDisplay *m_virtualDisplay;
+    StorageIndex m_storageIndex;
+    bool m_isIndexingStorage;
+    QPointer<Zero::BackgroundBackupOperation> m_backgroundBackup;
 };
 
 }
@@ -6,6 +6,7 @@
 #include <QPluginLoader>
 #include <QLoggingCategory>
 
+#include "allocationtracker.h"
 #include "protobufplugininterface.h"
 #include "mainresponseinterface.h"
 
@@ -32,6 +33,8 @@
 #include "rpc/guistartvirtualdisplayoperation.h"
 #include "rpc/guistopvirtualdisplayoperation.h"
 
+#include "rpc/preencodedoperation.h"
+
 Q_LOGGING_CATEGORY(LOG_SESSION, "RPC")
 
 using namespace Flipper;
@@ -61,6 +64,11 @@ bool ProtobufSession::isSessionUp() const
     return m_sessionState == Idle || m_sessionState == Running;
 }
 
+bool ProtobufSession::hasPendingOperations() const
+{
+    return !m_queue.isEmpty();
+}
+
 void ProtobufSession::setSerialPort(const QSerialPortInfo &portInfo)
 {
     m_portInfo = portInfo;
@@ -175,6 +183,24 @@ GuiScreenFrameOperation *ProtobufSession::guiSendScreenFrame(const QByteArray &s
     return enqueueOperation(new GuiScreenFrameOperation(getAndIncrementCounter(), screenData, this));
 }
 
+PreEncodedOperation *ProtobufSession::sendPreEncoded(const QByteArray &frames)
+{
+    return enqueueOperation(new PreEncodedOperation(getAndIncrementCounter(), frames, this));
+}
+
+const QString ProtobufSession::protobufPluginPath(int versionMajor)
+{
+#if defined(Q_OS_WINDOWS)
+    return QStringLiteral("flipperproto%1.dll").arg(versionMajor);
+#elif defined(Q_OS_MAC)
+    return QStringLiteral("libflipperproto%1.dylib").arg(versionMajor);
+#elif defined(Q_OS_LINUX)
+    return QStringLiteral("libflipperproto%1.so").arg(versionMajor);
+#else
+#error "Unsupported OS"
+#endif
+}
+
 void ProtobufSession::startSession()
 {
     if(m_sessionState != Stopped) {
@@ -233,6 +259,10 @@ void ProtobufSession::onSerialPortReadyRead()
         return;
     }
 
+    // Responses are decoded before they can be matched, and broadcasts such as screen frames
+    // arrive at any time, so decoding is not charged to the running operation
+    ALLOCATION_SCOPE("ProtobufSession", "Decode response");
+
     m_receivedData.append(m_serialPort->readAll());
     auto *response = m_plugin->decode(m_receivedData, this);
 
@@ -283,7 +313,11 @@ void ProtobufSession::processQueue()
     }
 
     m_currentOperation = m_queue.dequeue();
-    m_currentOperation->start();
+
+    {
+        ALLOCATION_SCOPE(m_currentOperation->metaObject()->className(), "Start");
+        m_currentOperation->start();
+    }
 
     connect(m_currentOperation, &AbstractOperation::finished, this, &ProtobufSession::onCurrentOperationFinished);
 
@@ -298,6 +332,8 @@ void ProtobufSession::writeToPort()
        return;
     }
 
+    ALLOCATION_SCOPE(m_currentOperation->metaObject()->className(), "Encode request");
+
     bool success;
 
     do {
@@ -360,7 +396,7 @@ void ProtobufSession::onCurrentOperationFinished()
 
 bool ProtobufSession::loadProtobufPlugin()
 {
-    m_loader->setFileName(protobufPluginPath());
+    m_loader->setFileName(protobufPluginPath(m_versionMajor));
 
     if(!(m_plugin = qobject_cast<ProtobufPluginInterface*>(m_loader->instance()))) {
         qCCritical(LOG_SESSION) << "Failed to load protobuf plugin:" << m_loader->errorString();
@@ -416,19 +452,6 @@ void ProtobufSession::clearOperationQueue()
     }
 }
 
-const QString ProtobufSession::protobufPluginPath() const
-{
-#if defined(Q_OS_WINDOWS)
-    return QStringLiteral("flipperproto%1.dll").arg(m_versionMajor);
-#elif defined(Q_OS_MAC)
-    return QStringLiteral("libflipperproto%1.dylib").arg(m_versionMajor);
-#elif defined(Q_OS_LINUX)
-    return QStringLiteral("libflipperproto%1.so").arg(m_versionMajor);
-#else
-#error "Unsupported OS"
-#endif
-}
-
 const QString ProtobufSession::prettyOperationDescription() const
 {
     return QStringLiteral("(%1) %2").arg(m_currentOperation->id()).arg(m_currentOperation->description());
@@ -436,11 +459,13 @@ const QString ProtobufSession::prettyOperationDescription() const
 
 void ProtobufSession::processMatchedResponse(QObject *response)
 {
+    ALLOCATION_SCOPE(m_currentOperation->metaObject()->className(), "Process response");
     m_currentOperation->feedResponse(response);
 }
 
 void ProtobufSession::processBroadcastResponse(QObject *response)
 {
+    ALLOCATION_SCOPE("Broadcast", "Process response");
     emit broadcastResponseReceived(response);
 }
 
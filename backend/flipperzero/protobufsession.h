@@ -36,6 +36,8 @@ class GuiSendInputOperation;
 class GuiStartVirtualDisplayOperation;
 class GuiStopVirtualDisplayOperation;
 
+class PreEncodedOperation;
+
 class ProtobufSession : public QObject, public Failable
 {
     Q_OBJECT
@@ -52,6 +54,8 @@ public:
     ~ProtobufSession();
 
     bool isSessionUp() const;
+    // Operations waiting behind the current one
+    bool hasPendingOperations() const;
 
     void setSerialPort(const QSerialPortInfo &portInfo);
 
@@ -81,6 +85,10 @@ public:
     GuiSendInputOperation *guiSendInput(int key, int type);
     GuiScreenFrameOperation *guiSendScreenFrame(const QByteArray &screenData);
 
+    PreEncodedOperation *sendPreEncoded(const QByteArray &frames);
+
+    static const QString protobufPluginPath(int versionMajor);
+
 signals:
     void sessionStatusChanged();
     void broadcastResponseReceived(QObject *response);
@@ -106,7 +114,6 @@ private:
 
     void stopEarly(BackendError::ErrorType error, const QString &errorString);
 
-    const QString protobufPluginPath() const;
     const QString prettyOperationDescription() const;
 
     uint32_t getAndIncrementCounter();
@@ -0,0 +1,108 @@
+#include "preencodedoperation.h"
+
+#include <QTimer>
+
+#include "protobufplugininterface.h"
+
+static constexpr int COMMAND_ID_SIZE = 4;
+static constexpr char COMMAND_ID_TAG = 0x08;
+
+using namespace Flipper;
+using namespace Zero;
+
+PreEncodedOperation::PreEncodedOperation(uint32_t id, const QByteArray &frames, QObject *parent):
+    AbstractProtobufOperation(id, parent),
+    m_frames(frames),
+    m_offset(0)
+{
+    // Write operations can be lenghty
+    setTimeout(60000);
+}
+
+const QString PreEncodedOperation::description() const
+{
+    return QStringLiteral("Pre-encoded (%1 bytes)").arg(m_frames.size());
+}
+
+bool PreEncodedOperation::hasMoreData() const
+{
+    return m_offset < m_frames.size();
+}
+
+const QByteArray PreEncodedOperation::encodeRequest(ProtobufPluginInterface *encoder)
+{
+    Q_UNUSED(encoder)
+
+    auto *data = m_frames.data() + m_offset;
+    const auto remaining = m_frames.size() - m_offset;
+    const auto size = frameSize(data, remaining);
+
+    if(size <= 0 || !patchCommandId(data, size, id())) {
+        const auto reason = QStringLiteral("Malformed pre-encoded frame at offset %1").arg(m_offset);
+        m_offset = m_frames.size();
+
+        // Do not finish while the session is still writing
+        QTimer::singleShot(0, this, [=]() {
+            abort(reason);
+        });
+
+        return QByteArray();
+    }
+
+    m_offset += size;
+    return QByteArray(data, size);
+}
+
+int PreEncodedOperation::frameSize(const char *data, int size)
+{
+    // Frames are length-delimited: a varint message length followed by the message itself
+    quint32 length = 0;
+
+    for(auto i = 0; i < qMin(size, 5); ++i) {
+        const auto byte = (quint8)data[i];
+        length |= (quint32)(byte & 0x7f) << (7 * i);
+
+        if(!(byte & 0x80)) {
+            const auto total = (qint64)length + i + 1;
+            return total <= size ? (int)total : -1;
+        }
+    }
+
+    return -1;
+}
+
+int PreEncodedOperation::commandIdOffset(const char *data, int size)
+{
+    // command_id is field 1, so it is always encoded first, right after the length prefix
+    auto i = 0;
+    while(i < size && ((quint8)data[i] & 0x80)) {
+        ++i;
+    }
+
+    const auto offset = i + 2;
+
+    if(offset + COMMAND_ID_SIZE > size || data[i + 1] != COMMAND_ID_TAG) {
+        return -1;
+    }
+
+    // The last byte of the padded varint must not have the continuation bit set
+    return ((quint8)data[offset + COMMAND_ID_SIZE - 1] & 0x80) ? -1 : offset;
+}
+
+bool PreEncodedOperation::patchCommandId(char *data, int size, uint32_t id)
+{
+    const auto offset = commandIdOffset(data, size);
+
+    if(offset < 0 || id > PlaceholderId) {
+        return false;
+    }
+
+    // Non-minimal, but valid varint encoding, keeping the frame size constant
+    auto *dst = data + offset;
+    dst[0] = (char)((id & 0x7f) | 0x80);
+    dst[1] = (char)(((id >> 7) & 0x7f) | 0x80);
+    dst[2] = (char)(((id >> 14) & 0x7f) | 0x80);
+    dst[3] = (char)((id >> 21) & 0x7f);
+
+    return true;
+}
@@ -0,0 +1,33 @@
+#pragma once
+
+#include "abstractprotobufoperation.h"
+
+#include <QByteArray>
+
+namespace Flipper {
+namespace Zero {
+
+class PreEncodedOperation : public AbstractProtobufOperation
+{
+    Q_OBJECT
+
+public:
+    // Largest command id that fits into the 4-byte varint reserved in every frame
+    static constexpr uint32_t PlaceholderId = 0x0fffffff;
+
+    PreEncodedOperation(uint32_t id, const QByteArray &frames, QObject *parent = nullptr);
+    const QString description() const override;
+    bool hasMoreData() const override;
+    const QByteArray encodeRequest(ProtobufPluginInterface *encoder) override;
+
+    static int frameSize(const char *data, int size);
+    static int commandIdOffset(const char *data, int size);
+    static bool patchCommandId(char *data, int size, uint32_t id);
+
+private:
+    QByteArray m_frames;
+    int m_offset;
+};
+
+}
+}
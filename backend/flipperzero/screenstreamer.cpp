@@ -20,7 +20,9 @@ ScreenStreamer::ScreenStreamer(DeviceState *deviceState, ProtobufSession *rpc, Q
     QObject(parent),
     m_deviceState(deviceState),
     m_streamState(StreamState::Stopped),
-    m_rpc(rpc)
+    m_rpc(rpc),
+    m_isPaused(false),
+    m_isStopPending(false)
 {}
 
 void ScreenStreamer::sendInputEvent(int key, int type)
@@ -35,31 +37,49 @@ void ScreenStreamer::sendInputEvent(int key, int type)
     });
 }
 
-void ScreenStreamer::start()
+bool ScreenStreamer::isPaused() const
 {
-    if(m_streamState != StreamState::Stopped) {
-        qCDebug(CATEGORY_SCREEN) << "Can't start while already running";
+    return m_isPaused;
+}
+
+void ScreenStreamer::setPaused(bool set)
+{
+    if(m_isPaused == set) {
         return;
     }
 
-    setStreamState(StreamState::Starting);
+    m_isPaused = set;
 
-    auto *operation = m_rpc->guiStartScreenStream();
+    if(m_isPaused && m_streamState == StreamState::Running) {
+        suspend();
+    } else if(!m_isPaused && m_streamState == StreamState::Paused) {
+        resume();
+    }
+}
 
-    connect(operation, &AbstractOperation::finished, this, [=]() {
-        if(operation->isError()) {
-            setStreamState(Stopped);
-            qCDebug(CATEGORY_SCREEN).noquote() << "Failed to initiate screen streaming: " << operation->errorString();
+void ScreenStreamer::start()
+{
+    if(m_streamState != StreamState::Stopped) {
+        qCDebug(CATEGORY_SCREEN) << "Can't start while already running";
+        return;
+    }
 
-        } else {
-            setStreamState(Running);
-        }
-    });
+    resume();
 }
 
 void ScreenStreamer::stop()
 {
-    if(m_streamState != StreamState::Running) {
+    if(m_streamState == StreamState::Starting) {
+        // Finish starting first, otherwise the device may be left streaming
+        m_isStopPending = true;
+        return;
+
+    } else if(m_streamState == StreamState::Paused) {
+        // Already stopped on the device side
+        setStreamState(StreamState::Stopped);
+        return;
+
+    } else if(m_streamState != StreamState::Running) {
         qCDebug(CATEGORY_SCREEN) << "Can't stop while not running";
         return;
     }
@@ -81,11 +101,56 @@ void ScreenStreamer::onBroadcastResponseReceived(QObject *response)
 {
     auto *screenFrameResponse = qobject_cast<GuiScreenFrameResponseInterface*>(response);
 
-    if(screenFrameResponse) {
+    // Frames still in flight after a pause are of no interest
+    if(screenFrameResponse && m_streamState == StreamState::Running) {
         m_deviceState->setScreenData(screenFrameResponse->screenFrame());
     }
 }
 
+void ScreenStreamer::suspend()
+{
+    qCDebug(CATEGORY_SCREEN) << "Pausing screen streaming";
+
+    setStreamState(StreamState::Paused);
+
+    auto *operation = m_rpc->guiStopScreenStream();
+
+    connect(operation, &AbstractOperation::finished, this, [=]() {
+        if(operation->isError()) {
+            qCDebug(CATEGORY_SCREEN).noquote() << "Failed to pause screen streaming: " << operation->errorString();
+        }
+    });
+}
+
+void ScreenStreamer::resume()
+{
+    if(m_streamState == StreamState::Paused) {
+        qCDebug(CATEGORY_SCREEN) << "Resuming screen streaming";
+    }
+
+    setStreamState(StreamState::Starting);
+
+    auto *operation = m_rpc->guiStartScreenStream();
+
+    connect(operation, &AbstractOperation::finished, this, [=]() {
+        if(operation->isError()) {
+            m_isStopPending = false;
+            setStreamState(Stopped);
+            qCDebug(CATEGORY_SCREEN).noquote() << "Failed to initiate screen streaming: " << operation->errorString();
+            return;
+        }
+
+        setStreamState(Running);
+
+        if(m_isStopPending) {
+            m_isStopPending = false;
+            stop();
+        } else if(m_isPaused) {
+            suspend();
+        }
+    });
+}
+
 void ScreenStreamer::setStreamState(StreamState newState)
 {
     if(newState == m_streamState) {
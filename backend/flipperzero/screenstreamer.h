@@ -18,7 +18,8 @@ public:
         Starting,
         Running,
         Stopping,
-        Stopped
+        Stopped,
+        Paused
     };
 
     Q_ENUM(StreamState)
@@ -26,6 +27,11 @@ public:
     ScreenStreamer(DeviceState *deviceState, ProtobufSession *rpc, QObject *parent = nullptr);
     void sendInputEvent(int key, int type);
 
+    // A paused stream is stopped on the device but still counts as enabled,
+    // it is restarted as soon as the pause is lifted.
+    bool isPaused() const;
+    void setPaused(bool set);
+
 public slots:
     void start();
     void stop();
@@ -35,9 +41,14 @@ public slots:
 private:
     void setStreamState(StreamState newState);
 
+    void suspend();
+    void resume();
+
     DeviceState *m_deviceState;
     StreamState m_streamState;
     ProtobufSession *m_rpc;
+    bool m_isPaused;
+    bool m_isStopPending;
 };
 
 }
@@ -0,0 +1,287 @@
+#include "storagebundle.h"
+
+#include <cstddef>
+
+#include <QDir>
+#include <QtEndian>
+#include <QFileInfo>
+#include <QDirIterator>
+
+#include "protobufplugininterface.h"
+#include "rpc/preencodedoperation.h"
+
+// Same chunk size as in StorageWriteOperation
+static constexpr qint64 CHUNK_SIZE = 512;
+static constexpr quint32 BUNDLE_MAGIC = 0x4e424651; // "QFBN"
+static constexpr quint32 BUNDLE_VERSION = 2;
+
+struct BundleHeader
+{
+    quint32 magic;
+    quint32 version;
+    quint32 commandCount;
+    quint16 protobufMajor;
+    quint16 protobufMinor;
+    quint64 payloadSize;
+};
+
+struct CommandHeader
+{
+    quint32 type;
+    quint32 size;
+};
+
+static_assert(sizeof(BundleHeader) == 24, "Check BundleHeader alignment");
+static_assert(sizeof(CommandHeader) == 8, "Check CommandHeader alignment");
+
+using namespace Flipper;
+using namespace Zero;
+
+StorageBundle::StorageBundle(const QString &fileName):
+    m_file(fileName),
+    m_data(nullptr),
+    m_payloadSize(0),
+    m_protobufMajor(-1),
+    m_protobufMinor(-1)
+{}
+
+StorageBundle::~StorageBundle()
+{
+    close();
+}
+
+const QString StorageBundle::fileName() const
+{
+    return m_file.fileName();
+}
+
+bool StorageBundle::create(ProtobufPluginInterface *encoder, int protobufMajor, int protobufMinor, const QString &sourcePath, const QByteArray &targetPath)
+{
+    close();
+    clearError();
+
+    QDir sourceDir(sourcePath);
+
+    if(!sourceDir.exists()) {
+        setError(BackendError::DiskError, QStringLiteral("Source directory does not exist: %1").arg(sourcePath));
+        return false;
+    }
+
+    QStringList entries;
+    QDirIterator it(sourcePath, QDir::Dirs | QDir::Files | QDir::NoDotAndDotDot, QDirIterator::Subdirectories);
+
+    while(it.hasNext()) {
+        entries.append(sourceDir.relativeFilePath(it.next()));
+    }
+
+    // Parent directories always come before their contents
+    entries.sort();
+
+    if(!m_file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        setError(BackendError::DiskError, QStringLiteral("Failed to open bundle for writing: %1").arg(m_file.errorString()));
+        return false;
+    }
+
+    BundleHeader header = {};
+
+    if(m_file.write((const char*)&header, sizeof(BundleHeader)) != sizeof(BundleHeader)) {
+        setError(BackendError::DiskError, QStringLiteral("Failed to write bundle header: %1").arg(m_file.errorString()));
+        m_file.close();
+        return false;
+    }
+
+    const auto placeholder = PreEncodedOperation::PlaceholderId;
+
+    for(const auto &entry : qAsConst(entries)) {
+        const auto filePath = targetPath + QByteArrayLiteral("/") + entry.toLocal8Bit();
+        const QFileInfo fileInfo(sourceDir.absoluteFilePath(entry));
+
+        QByteArray frames;
+        CommandType type;
+
+        if(fileInfo.isDir()) {
+            type = CommandType::Mkdir;
+            frames = encoder->storageMkDir(placeholder, filePath);
+
+        } else if(fileInfo.isFile()) {
+            QFile file(fileInfo.absoluteFilePath());
+
+            if(!file.open(QIODevice::ReadOnly)) {
+                setError(BackendError::DiskError, QStringLiteral("Failed to open file for reading: %1").arg(file.errorString()));
+                break;
+            }
+
+            type = CommandType::Write;
+
+            // Empty files still need a single frame
+            do {
+                const auto buf = file.read(CHUNK_SIZE);
+                const auto hasNext = file.bytesAvailable() > 0;
+                frames.append(encoder->storageWrite(placeholder, filePath, buf, hasNext));
+            } while(file.bytesAvailable() > 0);
+
+            m_payloadSize += file.size();
+
+        } else {
+            continue;
+        }
+
+        if(!writeCommand(type, frames)) {
+            break;
+        }
+
+        ++header.commandCount;
+    }
+
+    if(!isError()) {
+        header.magic = qToLittleEndian(BUNDLE_MAGIC);
+        header.version = qToLittleEndian(BUNDLE_VERSION);
+        header.commandCount = qToLittleEndian(header.commandCount);
+        header.protobufMajor = qToLittleEndian((quint16)protobufMajor);
+        header.protobufMinor = qToLittleEndian((quint16)protobufMinor);
+        header.payloadSize = qToLittleEndian<quint64>(m_payloadSize);
+
+        if(!m_file.seek(0) || (m_file.write((const char*)&header, sizeof(BundleHeader)) != sizeof(BundleHeader))) {
+            setError(BackendError::DiskError, QStringLiteral("Failed to write bundle header: %1").arg(m_file.errorString()));
+        }
+    }
+
+    m_file.close();
+    m_payloadSize = 0;
+
+    if(isError()) {
+        m_file.remove();
+    }
+
+    return !isError();
+}
+
+bool StorageBundle::open()
+{
+    close();
+    clearError();
+
+    if(!m_file.open(QIODevice::ReadOnly)) {
+        setError(BackendError::DiskError, QStringLiteral("Failed to open bundle: %1").arg(m_file.errorString()));
+        return false;
+    }
+
+    const auto fileSize = m_file.size();
+
+    if(fileSize < (qint64)sizeof(BundleHeader) || !(m_data = m_file.map(0, fileSize))) {
+        setError(BackendError::DataError, QStringLiteral("Failed to map bundle: %1").arg(m_file.errorString()));
+        close();
+        return false;
+    }
+
+    const auto *header = (const BundleHeader*)m_data;
+
+    if(qFromLittleEndian(header->magic) != BUNDLE_MAGIC || qFromLittleEndian(header->version) != BUNDLE_VERSION) {
+        setError(BackendError::DataError, QStringLiteral("Not a bundle file or unsupported version"));
+        close();
+        return false;
+    }
+
+    m_protobufMajor = qFromLittleEndian(header->protobufMajor);
+    m_protobufMinor = qFromLittleEndian(header->protobufMinor);
+
+    const auto commandCount = qFromLittleEndian(header->commandCount);
+    m_payloadSize = (qint64)qFromLittleEndian(header->payloadSize);
+    m_commands.reserve((int)commandCount);
+
+    qint64 offset = sizeof(BundleHeader);
+
+    for(quint32 i = 0; i < commandCount; ++i) {
+        if(offset + (qint64)sizeof(CommandHeader) > fileSize) {
+            break;
+        }
+
+        // Command headers are not necessarily aligned
+        const auto *commandHeader = m_data + offset;
+        const auto type = qFromLittleEndian<quint32>(commandHeader + offsetof(CommandHeader, type));
+        const auto size = qFromLittleEndian<quint32>(commandHeader + offsetof(CommandHeader, size));
+
+        offset += sizeof(CommandHeader);
+
+        if(offset + size > fileSize) {
+            break;
+        }
+
+        m_commands.append({(CommandType)type, (const char*)(m_data + offset), (int)size});
+        offset += size;
+    }
+
+    if(m_commands.size() != (int)commandCount) {
+        setError(BackendError::DataError, QStringLiteral("Bundle file is truncated"));
+        close();
+        return false;
+    }
+
+    return true;
+}
+
+void StorageBundle::close()
+{
+    m_commands.clear();
+
+    if(m_data) {
+        m_file.unmap(m_data);
+        m_data = nullptr;
+    }
+
+    if(m_file.isOpen()) {
+        m_file.close();
+    }
+}
+
+const StorageBundle::CommandList &StorageBundle::commands() const
+{
+    return m_commands;
+}
+
+qint64 StorageBundle::payloadSize() const
+{
+    return m_payloadSize;
+}
+
+int StorageBundle::protobufMajor() const
+{
+    return m_protobufMajor;
+}
+
+int StorageBundle::protobufMinor() const
+{
+    return m_protobufMinor;
+}
+
+bool StorageBundle::writeCommand(CommandType type, const QByteArray &frames)
+{
+    if(frames.isEmpty()) {
+        setError(BackendError::DataError, QStringLiteral("Failed to encode a bundle command"));
+        return false;
+    }
+
+    for(auto offset = 0; offset < frames.size();) {
+        const auto *frame = frames.constData() + offset;
+        const auto size = PreEncodedOperation::frameSize(frame, frames.size() - offset);
+
+        if(size <= 0 || PreEncodedOperation::commandIdOffset(frame, size) < 0) {
+            setError(BackendError::DataError, QStringLiteral("Encoder produced an unexpected frame layout"));
+            return false;
+        }
+
+        offset += size;
+    }
+
+    CommandHeader header;
+    header.type = qToLittleEndian((quint32)type);
+    header.size = qToLittleEndian((quint32)frames.size());
+
+    const auto success = (m_file.write((const char*)&header, sizeof(CommandHeader)) == sizeof(CommandHeader)) &&
+                         (m_file.write(frames) == frames.size());
+    if(!success) {
+        setError(BackendError::DiskError, QStringLiteral("Failed to write bundle: %1").arg(m_file.errorString()));
+    }
+
+    return success;
+}
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <QFile>
+#include <QVector>
+#include <QByteArray>
+
+#include "failable.h"
+
+class ProtobufPluginInterface;
+
+namespace Flipper {
+namespace Zero {
+
+/* A file of pre-encoded, length-delimited PB_Main frames,
+ * grouped into commands that share a single command id. */
+
+class StorageBundle : public Failable
+{
+public:
+    enum class CommandType : quint32 {
+        Mkdir = 0,
+        Write
+    };
+
+    struct Command {
+        CommandType type;
+        const char *data;
+        int size;
+    };
+
+    using CommandList = QVector<Command>;
+
+    StorageBundle(const QString &fileName);
+    ~StorageBundle();
+
+    const QString fileName() const;
+
+    // The encoder must be set up for the given protocol version, it is recorded in the header
+    bool create(ProtobufPluginInterface *encoder, int protobufMajor, int protobufMinor, const QString &sourcePath, const QByteArray &targetPath);
+
+    bool open();
+    void close();
+
+    const CommandList &commands() const;
+    qint64 payloadSize() const;
+
+    int protobufMajor() const;
+    int protobufMinor() const;
+
+private:
+    bool writeCommand(CommandType type, const QByteArray &frames);
+
+    QFile m_file;
+    uchar *m_data;
+    CommandList m_commands;
+    qint64 m_payloadSize;
+    int m_protobufMajor;
+    int m_protobufMinor;
+};
+
+}
+}
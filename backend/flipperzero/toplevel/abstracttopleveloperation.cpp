@@ -2,14 +2,18 @@
 
 #include <QTimer>
 
+#include "allocationtracker.h"
+
 #include "flipperzero/devicestate.h"
+#include "flipperzero/etaestimator.h"
 
 using namespace Flipper;
 using namespace Zero;
 
 AbstractTopLevelOperation::AbstractTopLevelOperation(DeviceState *deviceState, QObject *parent):
     AbstractOperation(parent),
-    m_deviceState(deviceState)
+    m_deviceState(deviceState),
+    m_estimator(nullptr)
 {
     m_deviceState->clearError();
     m_deviceState->setPersistent(true);
@@ -18,6 +22,7 @@ AbstractTopLevelOperation::AbstractTopLevelOperation(DeviceState *deviceState, Q
 AbstractTopLevelOperation::~AbstractTopLevelOperation()
 {
     m_deviceState->setPersistent(false);
+    m_deviceState->setEta(-1);
 }
 
 DeviceState *AbstractTopLevelOperation::deviceState() const
@@ -30,13 +35,38 @@ void AbstractTopLevelOperation::start()
     if(operationState() != AbstractOperation::Ready) {
         finishWithError(BackendError::UnknownError, QStringLiteral("Trying to start an operation that is either already running or has finished."));
     } else {
+        // Created here, as the class name is not known yet in the constructor
+        m_estimator = new EtaEstimator(metaObject()->className(), m_deviceState, this);
         advanceOperationState();
     }
 }
 
+void AbstractTopLevelOperation::setOperationState(int state)
+{
+    AbstractOperation::setOperationState(state);
+
+    if(!m_estimator) {
+        return;
+    } else if(state == AbstractOperation::Finished) {
+        m_estimator->finish(!isError());
+    } else {
+        m_estimator->beginStage(state);
+    }
+}
+
+void AbstractTopLevelOperation::setStageWorkload(qint64 bytes)
+{
+    if(m_estimator) {
+        m_estimator->setStageWorkload(bytes);
+    }
+}
+
 void AbstractTopLevelOperation::advanceOperationState()
 {
-    QTimer::singleShot(0, this, &AbstractTopLevelOperation::nextStateLogic);
+    QTimer::singleShot(0, this, [this]() {
+        ALLOCATION_SCOPE(metaObject()->className(), "State logic");
+        nextStateLogic();
+    });
 }
 
 void AbstractTopLevelOperation::registerSubOperation(AbstractOperation *operation)
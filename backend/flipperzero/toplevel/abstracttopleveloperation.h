@@ -6,6 +6,7 @@ namespace Flipper {
 namespace Zero {
 
 class DeviceState;
+class EtaEstimator;
 
 class AbstractTopLevelOperation : public AbstractOperation
 {
@@ -20,6 +21,9 @@ public:
     void start() override;
 
 protected:
+    void setOperationState(int state) override;
+    void setStageWorkload(qint64 bytes);
+
     void advanceOperationState();
     void registerSubOperation(AbstractOperation *operation);
     virtual void onSubOperationError(AbstractOperation *operation);
@@ -29,6 +33,7 @@ private slots:
 
 private:
     DeviceState *m_deviceState;
+    EtaEstimator *m_estimator;
 };
 
 }
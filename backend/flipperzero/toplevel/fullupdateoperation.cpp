@@ -131,12 +131,14 @@ void FullUpdateOperation::setBootMode()
 void FullUpdateOperation::downloadFirmware()
 {
     auto *file = m_helper->file(FirmwareHelper::FileIndex::Firmware);
+    setStageWorkload(file->size());
     registerSubOperation(m_recovery->downloadFirmware(file));
 }
 
 void FullUpdateOperation::downloadRadioFirmware()
 {
     auto *file = m_helper->file(FirmwareHelper::FileIndex::RadioFirmware);
+    setStageWorkload(file->size());
     registerSubOperation(m_recovery->downloadWirelessStack(file));
 }
 
@@ -154,6 +156,7 @@ void FullUpdateOperation::exitRecovery()
 void FullUpdateOperation::downloadAssets()
 {
     auto *file = m_helper->file(FirmwareHelper::FileIndex::AssetsTgz);
+    setStageWorkload(file->size());
     registerSubOperation(m_utility->downloadAssets(file));
 }
 
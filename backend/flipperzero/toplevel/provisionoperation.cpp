@@ -0,0 +1,85 @@
+#include "provisionoperation.h"
+
+#include <QFileInfo>
+#include <QCryptographicHash>
+
+#include "flipperzero/devicestate.h"
+
+#include "flipperzero/utilityinterface.h"
+#include "flipperzero/utility/bundlecompileoperation.h"
+#include "flipperzero/utility/bundledownloadoperation.h"
+
+#include "tempdirectories.h"
+
+using namespace Flipper;
+using namespace Zero;
+
+ProvisionOperation::ProvisionOperation(UtilityInterface *utility, DeviceState *state, const QString &sourcePath, QObject *parent):
+    AbstractTopLevelOperation(state, parent),
+    m_utility(utility),
+    m_sourcePath(sourcePath)
+{}
+
+const QString ProvisionOperation::description() const
+{
+    return QStringLiteral("Provision %1 @%2").arg(m_sourcePath, deviceState()->name());
+}
+
+void ProvisionOperation::nextStateLogic()
+{
+    if(operationState() == AbstractOperation::Ready) {
+        setOperationState(ProvisionOperation::CompilingBundle);
+        compileBundle();
+
+    } else if(operationState() == ProvisionOperation::CompilingBundle) {
+        setOperationState(ProvisionOperation::DownloadingBundle);
+        downloadBundle();
+
+    } else if(operationState() == ProvisionOperation::DownloadingBundle) {
+        finish();
+    }
+}
+
+void ProvisionOperation::compileBundle()
+{
+    const QFileInfo sourceInfo(m_sourcePath);
+
+    if(!deviceState()->deviceInfo().storage.isExternalPresent) {
+        finishWithError(BackendError::OperationError, QStringLiteral("External storage is not present"));
+        return;
+
+    } else if(!sourceInfo.exists()) {
+        finishWithError(BackendError::DiskError, QStringLiteral("Source path does not exist: %1").arg(m_sourcePath));
+        return;
+
+    } else if(!sourceInfo.isDir()) {
+        // Already a bundle file
+        m_bundleFile = m_sourcePath;
+        advanceOperationState();
+        return;
+    }
+
+    // Compile a directory only once per protocol version, so that subsequent runs can reuse it
+    const auto &pb = deviceState()->deviceInfo().protobuf;
+    const auto pathHash = QCryptographicHash::hash(sourceInfo.absoluteFilePath().toUtf8(), QCryptographicHash::Md5).toHex();
+    const auto fileName = QStringLiteral("%1-%2.%3.bundle").arg(QString(pathHash)).arg(pb.versionMajor).arg(pb.versionMinor);
+
+    m_bundleFile = globalTempDirs->root().absoluteFilePath(fileName);
+
+    if(QFileInfo::exists(m_bundleFile)) {
+        advanceOperationState();
+    } else {
+        registerSubOperation(m_utility->compileBundle(sourceInfo.absoluteFilePath(), m_bundleFile));
+    }
+}
+
+void ProvisionOperation::downloadBundle()
+{
+    registerSubOperation(m_utility->downloadBundle(m_bundleFile));
+}
+
+void ProvisionOperation::onSubOperationError(AbstractOperation *operation)
+{
+    const auto keepError = operationState() == ProvisionOperation::CompilingBundle;
+    finishWithError(keepError ? operation->error() : BackendError::OperationError, operation->errorString());
+}
@@ -0,0 +1,38 @@
+#pragma once
+
+#include "abstracttopleveloperation.h"
+
+namespace Flipper {
+namespace Zero {
+
+class UtilityInterface;
+
+class ProvisionOperation : public AbstractTopLevelOperation
+{
+    Q_OBJECT
+
+    enum OperationState {
+        CompilingBundle = AbstractOperation::User,
+        DownloadingBundle
+    };
+
+public:
+    ProvisionOperation(UtilityInterface *utility, DeviceState *state, const QString &sourcePath, QObject *parent = nullptr);
+    const QString description() const override;
+
+private slots:
+    void nextStateLogic() override;
+
+private:
+    void compileBundle();
+    void downloadBundle();
+
+    void onSubOperationError(AbstractOperation *operation) override;
+
+    UtilityInterface *m_utility;
+    QString m_sourcePath;
+    QString m_bundleFile;
+};
+
+}
+}
@@ -1,7 +1,9 @@
 #include "settingsrestoreoperation.h"
 
+#include <QDir>
 #include <QUrl>
 #include <QTimer>
+#include <QDirIterator>
 
 #include "flipperzero/devicestate.h"
 
@@ -46,6 +48,16 @@ void SettingsRestoreOperation::nextStateLogic()
 
 void SettingsRestoreOperation::restoreBackup()
 {
+    qint64 totalSize = 0;
+    QDirIterator it(QDir(m_backupDir).absoluteFilePath(deviceState()->deviceInfo().name), QDir::Files, QDirIterator::Subdirectories);
+
+    while(it.hasNext()) {
+        it.next();
+        totalSize += it.fileInfo().size();
+    }
+
+    setStageWorkload(totalSize);
+
     m_elapsed.start();
     registerSubOperation(m_utility->restoreInternalStorage(m_backupDir));
 }
@@ -2,6 +2,8 @@
 
 #include <QTimer>
 
+#include "allocationtracker.h"
+
 #include "flipperzero/recovery.h"
 #include "flipperzero/devicestate.h"
 
@@ -35,5 +37,8 @@ DeviceState *AbstractUtilityOperation::deviceState() const
 
 void AbstractUtilityOperation::advanceOperationState()
 {
-    QTimer::singleShot(0, this, &AbstractUtilityOperation::nextStateLogic);
+    QTimer::singleShot(0, this, [this]() {
+        ALLOCATION_SCOPE(metaObject()->className(), "State logic");
+        nextStateLogic();
+    });
 }
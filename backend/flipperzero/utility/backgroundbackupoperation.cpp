@@ -0,0 +1,237 @@
+#include "backgroundbackupoperation.h"
+
+#include <QTimer>
+#include <QBuffer>
+#include <QCryptographicHash>
+
+#include <algorithm>
+
+#include "flipperzero/devicestate.h"
+#include "flipperzero/protobufsession.h"
+#include "flipperzero/rpc/storagereadoperation.h"
+
+#include "getfiletreeoperation.h"
+#include "backgroundfilewriter.h"
+
+using namespace Flipper;
+using namespace Zero;
+
+// How long to wait before checking again whether other RPC operations are done
+static constexpr int YIELD_INTERVAL_MS = 50;
+
+BackgroundBackupOperation::BackgroundBackupOperation(ProtobufSession *rpc, DeviceState *deviceState, const QString &backupPath,
+                                                     const QByteArray &lastSignature, QObject *parent):
+    AbstractUtilityOperation(rpc, deviceState, parent),
+    m_backupDir(backupPath),
+    m_deviceDirName(QByteArrayLiteral("/int")),
+    m_lastSignature(lastSignature),
+    m_writer(new BackgroundFileWriter()),
+    m_fileIndex(0),
+    m_fileCount(0),
+    m_totalSize(0),
+    m_isSkipped(false)
+{
+    connect(m_writer, &BackgroundFileWriter::finished, this, &BackgroundBackupOperation::onFileWritten);
+}
+
+BackgroundBackupOperation::~BackgroundBackupOperation()
+{
+    // Destroyed without finishing when the device goes away
+    if(operationState() != AbstractOperation::Finished && operationState() != State::Aborting) {
+        m_writer->cancel();
+        m_writer->removePath(m_backupDir.absolutePath());
+    }
+
+    m_writer->deleteWhenIdle();
+}
+
+const QString BackgroundBackupOperation::description() const
+{
+    return QStringLiteral("Background Backup %1 @%2").arg(m_deviceDirName, deviceState()->name());
+}
+
+bool BackgroundBackupOperation::isSkipped() const
+{
+    return m_isSkipped;
+}
+
+const QByteArray &BackgroundBackupOperation::signature() const
+{
+    return m_signature;
+}
+
+int BackgroundBackupOperation::fileCount() const
+{
+    return m_fileCount;
+}
+
+qint64 BackgroundBackupOperation::totalSize() const
+{
+    return m_totalSize;
+}
+
+void BackgroundBackupOperation::cancel()
+{
+    abort(BackendError::OperationError, QStringLiteral("Background backup was cancelled"));
+}
+
+void BackgroundBackupOperation::nextStateLogic()
+{
+    if(operationState() == BasicOperationState::Ready) {
+        setOperationState(State::GettingFileTree);
+        getFileTree();
+
+    } else if(operationState() == State::GettingFileTree) {
+        setOperationState(State::ReadingFiles);
+        readFiles();
+
+    } else if(operationState() == State::ReadingFiles) {
+        setOperationState(State::WritingFiles);
+        writeFiles();
+    }
+}
+
+void BackgroundBackupOperation::getFileTree()
+{
+    auto *operation = new GetFileTreeOperation(rpc(), deviceState(), m_deviceDirName, this);
+
+    connect(operation, &AbstractOperation::finished, this, [=]() {
+        if(operationState() != State::GettingFileTree) {
+            // Cancelled in the meantime
+        } else if(operation->isError()) {
+            abort(BackendError::BackupError, operation->errorString());
+
+        } else {
+            m_fileList = operation->files();
+            m_signature = treeSignature(m_fileList);
+
+            if(m_signature == m_lastSignature) {
+                m_isSkipped = true;
+                finish();
+            } else {
+                advanceOperationState();
+            }
+        }
+
+        operation->deleteLater();
+    });
+
+    operation->start();
+}
+
+void BackgroundBackupOperation::readFiles()
+{
+    m_writer->makePath(m_backupDir.absoluteFilePath(QString(m_deviceDirName.mid(1))));
+    readNextFile();
+}
+
+void BackgroundBackupOperation::readNextFile()
+{
+    if(operationState() != State::ReadingFiles) {
+        return;
+
+    } else if(rpc()->hasPendingOperations()) {
+        // Let interactive requests through first
+        QTimer::singleShot(YIELD_INTERVAL_MS, this, &BackgroundBackupOperation::readNextFile);
+        return;
+    }
+
+    while(m_fileIndex < m_fileList.size()) {
+        const auto &fileInfo = m_fileList.at(m_fileIndex++);
+        const auto filePath = m_backupDir.absoluteFilePath(QString(fileInfo.absolutePath.mid(1)));
+
+        if(fileInfo.type == FileType::Directory) {
+            m_writer->makePath(filePath);
+
+        } else if(fileInfo.type != FileType::RegularFile) {
+            continue;
+
+        } else if(fileInfo.size == 0) {
+            // Nothing to read
+            ++m_fileCount;
+            m_writer->write(filePath, QByteArray());
+
+        } else {
+            auto *buffer = new QBuffer();
+            buffer->open(QIODevice::WriteOnly);
+
+            auto *operation = rpc()->storageRead(fileInfo.absolutePath, buffer);
+            // The read operation outlives this one if cancelled
+            buffer->setParent(operation);
+
+            connect(operation, &AbstractOperation::finished, this, [=]() {
+                if(operationState() != State::ReadingFiles) {
+                    return;
+                } else if(operation->isError()) {
+                    abort(BackendError::BackupError, operation->errorString());
+                    return;
+                }
+
+                ++m_fileCount;
+                m_totalSize += buffer->size();
+                m_writer->write(filePath, buffer->data());
+
+                readNextFile();
+            });
+
+            return;
+        }
+    }
+
+    advanceOperationState();
+}
+
+void BackgroundBackupOperation::writeFiles()
+{
+    if(!m_writer->pendingCount()) {
+        finish();
+    }
+}
+
+void BackgroundBackupOperation::abort(BackendError::ErrorType error, const QString &errorString)
+{
+    if(operationState() == AbstractOperation::Finished || operationState() == State::Aborting) {
+        return;
+    }
+
+    setOperationState(State::Aborting);
+    setError(error, errorString);
+
+    // Skip whatever is still queued and clean up after the file being written, if any
+    m_writer->cancel();
+    m_writer->removePath(m_backupDir.absolutePath());
+}
+
+void BackgroundBackupOperation::onFileWritten(const QString &fileName, bool success)
+{
+    if(operationState() == State::Aborting) {
+        if(!m_writer->pendingCount()) {
+            finish();
+        }
+
+    } else if(operationState() == AbstractOperation::Finished) {
+        return;
+    } else if(!success) {
+        abort(BackendError::DiskError, QStringLiteral("Failed to write: %1").arg(fileName));
+    } else if(operationState() == State::WritingFiles && !m_writer->pendingCount()) {
+        finish();
+    }
+}
+
+const QByteArray BackgroundBackupOperation::treeSignature(const FileInfoList &files)
+{
+    auto sorted = files;
+
+    std::sort(sorted.begin(), sorted.end(), [](const FileInfo &a, const FileInfo &b) {
+        return a.absolutePath < b.absolutePath;
+    });
+
+    // Names, types and sizes only: timestamps are not available over RPC
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+
+    for(const auto &fileInfo : qAsConst(sorted)) {
+        hash.addData(fileInfo.absolutePath + '\0' + QByteArray::number((int)fileInfo.type) + '\0' + QByteArray::number(fileInfo.size) + '\n');
+    }
+
+    return hash.result().toHex();
+}
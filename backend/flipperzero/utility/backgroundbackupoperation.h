@@ -0,0 +1,73 @@
+#pragma once
+
+#include "abstractutilityoperation.h"
+
+#include <QDir>
+
+#include "fileinfo.h"
+
+class BackgroundFileWriter;
+
+namespace Flipper {
+namespace Zero {
+
+/* Low-impact variant of UserBackupOperation for unattended use.
+ *
+ * Does nothing if the file tree signature matches the one of the previous backup.
+ * Otherwise files are read one at a time, letting any other queued RPC
+ * operation go first, and written to disk on an idle-priority thread. */
+
+class BackgroundBackupOperation : public AbstractUtilityOperation
+{
+    Q_OBJECT
+
+    enum State {
+        GettingFileTree = AbstractOperation::User,
+        ReadingFiles,
+        WritingFiles,
+        Aborting
+    };
+
+public:
+    BackgroundBackupOperation(ProtobufSession *rpc, DeviceState *deviceState, const QString &backupPath,
+                              const QByteArray &lastSignature, QObject *parent = nullptr);
+    ~BackgroundBackupOperation();
+
+    const QString description() const override;
+
+    bool isSkipped() const;
+    const QByteArray &signature() const;
+    int fileCount() const;
+    qint64 totalSize() const;
+
+    // Finishes with an error once the partial backup has been removed from disk
+    void cancel();
+
+private slots:
+    void nextStateLogic() override;
+    void readNextFile();
+    void onFileWritten(const QString &fileName, bool success);
+
+private:
+    void getFileTree();
+    void readFiles();
+    void writeFiles();
+    void abort(BackendError::ErrorType error, const QString &errorString);
+
+    static const QByteArray treeSignature(const FileInfoList &files);
+
+    QDir m_backupDir;
+    QByteArray m_deviceDirName;
+    QByteArray m_lastSignature;
+    QByteArray m_signature;
+    FileInfoList m_fileList;
+    BackgroundFileWriter *m_writer;
+
+    int m_fileIndex;
+    int m_fileCount;
+    qint64 m_totalSize;
+    bool m_isSkipped;
+};
+
+}
+}
@@ -0,0 +1,70 @@
+#include "bundlecompileoperation.h"
+
+#include <QPluginLoader>
+#include <QElapsedTimer>
+#include <QLoggingCategory>
+
+#include "protobufplugininterface.h"
+
+#include "flipperzero/devicestate.h"
+#include "flipperzero/storagebundle.h"
+#include "flipperzero/protobufsession.h"
+
+Q_DECLARE_LOGGING_CATEGORY(CATEGORY_UTILITY)
+
+using namespace Flipper;
+using namespace Zero;
+
+BundleCompileOperation::BundleCompileOperation(ProtobufSession *rpc, DeviceState *deviceState, const QString &sourcePath, const QString &bundleFile, QObject *parent):
+    AbstractUtilityOperation(rpc, deviceState, parent),
+    m_sourcePath(sourcePath),
+    m_bundleFile(bundleFile),
+    m_deviceDirName(QByteArrayLiteral("/ext"))
+{}
+
+const QString BundleCompileOperation::description() const
+{
+    return QStringLiteral("Compile Bundle %1 @%2").arg(m_sourcePath, deviceState()->name());
+}
+
+void BundleCompileOperation::nextStateLogic()
+{
+    if(operationState() == AbstractOperation::Ready) {
+        setOperationState(BundleCompileOperation::CompilingBundle);
+        compileBundle();
+
+    } else if(operationState() == BundleCompileOperation::CompilingBundle) {
+        finish();
+    }
+}
+
+void BundleCompileOperation::compileBundle()
+{
+    deviceState()->setStatusString(tr("Preparing files..."));
+
+    // The bundle must be encoded with the same protocol version the device speaks
+    const auto &pb = deviceState()->deviceInfo().protobuf;
+
+    QPluginLoader loader(ProtobufSession::protobufPluginPath(pb.versionMajor));
+    auto *encoder = qobject_cast<ProtobufPluginInterface*>(loader.instance());
+
+    if(!encoder) {
+        finishWithError(BackendError::UnknownError, QStringLiteral("Failed to load protobuf plugin: %1").arg(loader.errorString()));
+        return;
+    }
+
+    encoder->setMinorVersion(pb.versionMinor);
+
+    QElapsedTimer timer;
+    timer.start();
+
+    StorageBundle bundle(m_bundleFile);
+
+    if(!bundle.create(encoder, pb.versionMajor, pb.versionMinor, m_sourcePath, m_deviceDirName)) {
+        finishWithError(bundle.error(), bundle.errorString());
+        return;
+    }
+
+    qCDebug(CATEGORY_UTILITY).noquote() << "Compiled bundle" << m_bundleFile << "in" << timer.elapsed() << "ms";
+    advanceOperationState();
+}
@@ -0,0 +1,32 @@
+#pragma once
+
+#include "abstractutilityoperation.h"
+
+namespace Flipper {
+namespace Zero {
+
+class BundleCompileOperation : public AbstractUtilityOperation
+{
+    Q_OBJECT
+
+    enum State {
+        CompilingBundle = AbstractOperation::User
+    };
+
+public:
+    BundleCompileOperation(ProtobufSession *rpc, DeviceState *deviceState, const QString &sourcePath, const QString &bundleFile, QObject *parent = nullptr);
+    const QString description() const override;
+
+private slots:
+    void nextStateLogic() override;
+
+private:
+    void compileBundle();
+
+    QString m_sourcePath;
+    QString m_bundleFile;
+    QByteArray m_deviceDirName;
+};
+
+}
+}
@@ -0,0 +1,113 @@
+#include "bundledownloadoperation.h"
+
+#include <QLoggingCategory>
+
+#include "flipperzero/devicestate.h"
+#include "flipperzero/protobufsession.h"
+#include "flipperzero/rpc/preencodedoperation.h"
+
+Q_DECLARE_LOGGING_CATEGORY(CATEGORY_UTILITY)
+
+using namespace Flipper;
+using namespace Zero;
+
+BundleDownloadOperation::BundleDownloadOperation(ProtobufSession *rpc, DeviceState *deviceState, const QString &bundleFile, QObject *parent):
+    AbstractUtilityOperation(rpc, deviceState, parent),
+    m_bundle(bundleFile),
+    m_totalSize(0),
+    m_sentSize(0),
+    m_nextCommand(0)
+{}
+
+const QString BundleDownloadOperation::description() const
+{
+    return QStringLiteral("Download Bundle %1 @%2").arg(m_bundle.fileName(), deviceState()->name());
+}
+
+void BundleDownloadOperation::nextStateLogic()
+{
+    if(operationState() == AbstractOperation::Ready) {
+        setOperationState(BundleDownloadOperation::OpeningBundle);
+        openBundle();
+
+    } else if(operationState() == BundleDownloadOperation::OpeningBundle) {
+        setOperationState(BundleDownloadOperation::WritingFiles);
+        writeFiles();
+
+    } else if(operationState() == BundleDownloadOperation::WritingFiles) {
+        m_bundle.close();
+        finish();
+    }
+}
+
+void BundleDownloadOperation::openBundle()
+{
+    if(!m_bundle.open()) {
+        finishWithError(m_bundle.error(), m_bundle.errorString());
+        return;
+    }
+
+    // Frames encoded for another protocol version may not be decoded correctly by the device
+    const auto &pb = deviceState()->deviceInfo().protobuf;
+
+    if(m_bundle.protobufMajor() != pb.versionMajor || m_bundle.protobufMinor() != pb.versionMinor) {
+        finishWithError(BackendError::DataError, QStringLiteral("Bundle was encoded for protocol version %1.%2, device uses %3.%4")
+                        .arg(m_bundle.protobufMajor()).arg(m_bundle.protobufMinor()).arg(pb.versionMajor).arg(pb.versionMinor));
+        m_bundle.close();
+        return;
+    }
+
+    for(const auto &command : m_bundle.commands()) {
+        m_totalSize += command.size;
+    }
+
+    advanceOperationState();
+}
+
+void BundleDownloadOperation::writeFiles()
+{
+    if(m_bundle.commands().isEmpty()) {
+        qCDebug(CATEGORY_UTILITY) << "Bundle is empty, skipping to the end";
+        advanceOperationState();
+        return;
+    }
+
+    deviceState()->setStatusString(tr("Writing files..."));
+    deviceState()->setProgress(0);
+
+    sendNextCommand();
+}
+
+void BundleDownloadOperation::sendNextCommand()
+{
+    const auto &command = m_bundle.commands().at(m_nextCommand++);
+    const auto isMkdir = command.type == StorageBundle::CommandType::Mkdir;
+    const auto size = command.size;
+
+    // Each command is copied out of the mapped bundle, since the operation patches the command id into its frames.
+    // The session writes the next operation only after the current one has finished, so commands are sent one by one.
+    auto *op = rpc()->sendPreEncoded(QByteArray(command.data, command.size));
+
+    connect(op, &AbstractOperation::finished, this, [=]() {
+        if(operationState() == AbstractOperation::Finished) {
+            return;
+
+        } else if(op->isError() && !isMkdir) {
+            finishWithError(BackendError::OperationError, op->errorString());
+            return;
+
+        } else if(op->isError()) {
+            // Target directories may exist already
+            qCDebug(CATEGORY_UTILITY).noquote() << "Ignoring mkdir error:" << op->errorString();
+        }
+
+        m_sentSize += size;
+        deviceState()->setProgress(100.0 * m_sentSize / m_totalSize);
+
+        if(m_nextCommand < m_bundle.commands().size()) {
+            sendNextCommand();
+        } else {
+            advanceOperationState();
+        }
+    });
+}
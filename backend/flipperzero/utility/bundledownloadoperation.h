@@ -0,0 +1,38 @@
+#pragma once
+
+#include "abstractutilityoperation.h"
+
+#include "flipperzero/storagebundle.h"
+
+namespace Flipper {
+namespace Zero {
+
+class BundleDownloadOperation : public AbstractUtilityOperation
+{
+    Q_OBJECT
+
+    enum State {
+        OpeningBundle = AbstractOperation::User,
+        WritingFiles
+    };
+
+public:
+    BundleDownloadOperation(ProtobufSession *rpc, DeviceState *deviceState, const QString &bundleFile, QObject *parent = nullptr);
+    const QString description() const override;
+
+private slots:
+    void nextStateLogic() override;
+
+private:
+    void openBundle();
+    void writeFiles();
+    void sendNextCommand();
+
+    StorageBundle m_bundle;
+    qint64 m_totalSize;
+    qint64 m_sentSize;
+    int m_nextCommand;
+};
+
+}
+}
@@ -0,0 +1,61 @@
+#include "indexstorageoperation.h"
+
+#include "flipperzero/devicestate.h"
+
+#include "getfiletreeoperation.h"
+#include "storageindex.h"
+
+using namespace Flipper;
+using namespace Zero;
+
+IndexStorageOperation::IndexStorageOperation(ProtobufSession *rpc, DeviceState *deviceState, StorageIndex *index, QObject *parent):
+    AbstractUtilityOperation(rpc, deviceState, parent),
+    m_index(index)
+{}
+
+const QString IndexStorageOperation::description() const
+{
+    return QStringLiteral("Index Storage @%1").arg(deviceState()->name());
+}
+
+void IndexStorageOperation::nextStateLogic()
+{
+    if(operationState() == BasicOperationState::Ready) {
+        m_rootPaths.append(QByteArrayLiteral("/int"));
+
+        if(deviceState()->deviceInfo().storage.isExternalPresent) {
+            m_rootPaths.append(QByteArrayLiteral("/ext"));
+        }
+
+        setOperationState(State::GettingFileTree);
+        getFileTree();
+
+    } else if(operationState() == State::GettingFileTree) {
+        if(!m_rootPaths.isEmpty()) {
+            getFileTree();
+
+        } else {
+            // Only the difference is applied, unchanged entries keep their place in the index
+            m_index->update(m_fileList);
+            finish();
+        }
+    }
+}
+
+void IndexStorageOperation::getFileTree()
+{
+    auto *operation = new GetFileTreeOperation(rpc(), deviceState(), m_rootPaths.takeFirst(), this);
+
+    connect(operation, &AbstractOperation::finished, this, [=]() {
+        if(operation->isError()) {
+            finishWithError(operation->error(), operation->errorString());
+        } else {
+            m_fileList.append(operation->files());
+            advanceOperationState();
+        }
+
+        operation->deleteLater();
+    });
+
+    operation->start();
+}
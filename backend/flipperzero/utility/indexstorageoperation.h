@@ -0,0 +1,38 @@
+#pragma once
+
+#include "abstractutilityoperation.h"
+
+#include <QByteArrayList>
+
+#include "fileinfo.h"
+
+class StorageIndex;
+
+namespace Flipper {
+namespace Zero {
+
+class IndexStorageOperation : public AbstractUtilityOperation
+{
+    Q_OBJECT
+
+    enum State {
+        GettingFileTree = AbstractOperation::User
+    };
+
+public:
+    IndexStorageOperation(ProtobufSession *rpc, DeviceState *deviceState, StorageIndex *index, QObject *parent = nullptr);
+    const QString description() const override;
+
+private slots:
+    void nextStateLogic() override;
+
+private:
+    void getFileTree();
+
+    StorageIndex *m_index;
+    QByteArrayList m_rootPaths;
+    FileInfoList m_fileList;
+};
+
+}
+}
@@ -1,5 +1,6 @@
 #include "utilityinterface.h"
 
+#include <QTimer>
 #include <QLoggingCategory>
 
 #include "flipperzero/utility/restartoperation.h"
@@ -8,6 +9,10 @@
 #include "flipperzero/utility/startrecoveryoperation.h"
 #include "flipperzero/utility/assetsdownloadoperation.h"
 #include "flipperzero/utility/factoryresetutiloperation.h"
+#include "flipperzero/utility/bundlecompileoperation.h"
+#include "flipperzero/utility/bundledownloadoperation.h"
+#include "flipperzero/utility/indexstorageoperation.h"
+#include "flipperzero/utility/backgroundbackupoperation.h"
 
 Q_LOGGING_CATEGORY(CATEGORY_UTILITY, "UTILITY")
 
@@ -62,6 +67,48 @@ FactoryResetUtilOperation *UtilityInterface::factoryReset()
     return operation;
 }
 
+BundleCompileOperation *UtilityInterface::compileBundle(const QString &sourcePath, const QString &bundleFile)
+{
+    auto *operation = new BundleCompileOperation(m_rpc, m_deviceState, sourcePath, bundleFile, this);
+    enqueueOperation(operation);
+    return operation;
+}
+
+BundleDownloadOperation *UtilityInterface::downloadBundle(const QString &bundleFile)
+{
+    auto *operation = new BundleDownloadOperation(m_rpc, m_deviceState, bundleFile, this);
+    enqueueOperation(operation);
+    return operation;
+}
+
+IndexStorageOperation *UtilityInterface::indexStorage(StorageIndex *index)
+{
+    auto *operation = new IndexStorageOperation(m_rpc, m_deviceState, index, this);
+    enqueueOperation(operation);
+    return operation;
+}
+
+BackgroundBackupOperation *UtilityInterface::backupInBackground(const QString &backupPath, const QByteArray &lastSignature)
+{
+    auto *operation = new BackgroundBackupOperation(m_rpc, m_deviceState, backupPath, lastSignature, this);
+
+    // Not queued, so that it does not hold up other operations: it yields to them at the RPC level instead
+    connect(operation, &AbstractOperation::finished, this, [=]() {
+        if(operation->isError()) {
+            qCWarning(loggingCategory()).noquote() << operation->description() << "ERROR:" << operation->errorString();
+        } else {
+            qCInfo(loggingCategory()).noquote() << operation->description() << "SUCCESS";
+        }
+
+        operation->deleteLater();
+    });
+
+    qCInfo(loggingCategory()).noquote() << operation->description() << "START";
+    QTimer::singleShot(0, operation, &AbstractOperation::start);
+
+    return operation;
+}
+
 const QLoggingCategory &UtilityInterface::loggingCategory() const
 {
     return CATEGORY_UTILITY();
@@ -3,6 +3,7 @@
 #include "abstractoperationrunner.h"
 
 class QIODevice;
+class StorageIndex;
 
 namespace Flipper {
 namespace Zero {
@@ -16,6 +17,10 @@ class AssetsDownloadOperation;
 class UserBackupOperation;
 class UserRestoreOperation;
 class RestartOperation;
+class BundleCompileOperation;
+class BundleDownloadOperation;
+class IndexStorageOperation;
+class BackgroundBackupOperation;
 
 class UtilityInterface : public AbstractOperationRunner
 {
@@ -30,6 +35,11 @@ public:
     UserRestoreOperation *restoreInternalStorage(const QString &backupPath);
     RestartOperation *restartDevice();
     FactoryResetUtilOperation *factoryReset();
+    BundleCompileOperation *compileBundle(const QString &sourcePath, const QString &bundleFile);
+    BundleDownloadOperation *downloadBundle(const QString &bundleFile);
+    IndexStorageOperation *indexStorage(StorageIndex *index);
+    // Starts right away instead of being queued, the operation deletes itself when finished
+    BackgroundBackupOperation *backupInBackground(const QString &backupPath, const QByteArray &lastSignature);
 
 private:
     const QLoggingCategory &loggingCategory() const override;
@@ -34,6 +34,12 @@ void VirtualDisplay::start(const QByteArray &firstFrame)
         } else {
             setDisplayState(DisplayState::Running);
         }
+
+        if(!m_pendingFrame.isEmpty()) {
+            const auto frame = m_pendingFrame;
+            m_pendingFrame.clear();
+            showFrame(frame);
+        }
     });
 }
 
@@ -50,6 +56,7 @@ void VirtualDisplay::sendFrame(const QByteArray &screenFrame)
 
 void VirtualDisplay::stop()
 {
+    m_pendingFrame.clear();
     setDisplayState(DisplayState::Stopping);
 
     auto *operation = m_rpc->guiStopVirtualDisplay();
@@ -63,6 +70,19 @@ void VirtualDisplay::stop()
     });
 }
 
+void VirtualDisplay::showFrame(const QByteArray &screenFrame)
+{
+    if(m_displayState == DisplayState::Running) {
+        sendFrame(screenFrame);
+    } else if(m_displayState == DisplayState::Stopped) {
+        start(screenFrame);
+    } else if(m_displayState == DisplayState::Starting) {
+        m_pendingFrame = screenFrame;
+    } else {
+        qCDebug(LOG_VIRTDISPLAY) << "Dropping screen frame while the display is stopping";
+    }
+}
+
 void VirtualDisplay::setDisplayState(DisplayState newState)
 {
     if(newState == m_displayState) {
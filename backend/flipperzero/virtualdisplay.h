@@ -30,12 +30,16 @@ public slots:
     void sendFrame(const QByteArray &screenFrame);
     void stop();
 
+    // Starts the display if needed, only the latest frame is kept while it is starting
+    void showFrame(const QByteArray &screenFrame);
+
 private:
     void setDisplayState(DisplayState newState);
 
     DeviceState *m_deviceState;
     ProtobufSession *m_rpc;
     DisplayState m_displayState;
+    QByteArray m_pendingFrame;
 };
 
 }
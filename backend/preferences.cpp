@@ -3,6 +3,8 @@
 #define FIRMWARE_UPDATE_CHANNEL_KEY (QStringLiteral("FirmwareUpdateChannel"))
 #define APPLICATION_UPDATE_CHANNEL_KEY (QStringLiteral("ApplicationUpdateChannel"))
 #define CHECK_APPLICATION_UPDATES_KEY (QStringLiteral("CheckApplicatonUpdates"))
+#define BACKGROUND_BACKUP_PATH_KEY (QStringLiteral("BackgroundBackupPath"))
+#define BACKGROUND_BACKUP_INTERVAL_KEY (QStringLiteral("BackgroundBackupInterval"))
 
 Preferences::Preferences(QObject *parent):
     QObject(parent)
@@ -74,3 +76,33 @@ void Preferences::setCheckApplicationUpdates(bool set)
     m_settings.setValue(CHECK_APPLICATION_UPDATES_KEY, set);
     emit checkApplicationUpdatesChanged();
 }
+
+const QString Preferences::backgroundBackupPath() const
+{
+    return m_settings.value(BACKGROUND_BACKUP_PATH_KEY).toString();
+}
+
+void Preferences::setBackgroundBackupPath(const QString &newPath)
+{
+    if(newPath == backgroundBackupPath()) {
+        return;
+    }
+
+    m_settings.setValue(BACKGROUND_BACKUP_PATH_KEY, newPath);
+    emit backgroundBackupPathChanged();
+}
+
+int Preferences::backgroundBackupInterval() const
+{
+    return m_settings.value(BACKGROUND_BACKUP_INTERVAL_KEY, 0).toInt();
+}
+
+void Preferences::setBackgroundBackupInterval(int minutes)
+{
+    if(minutes == backgroundBackupInterval()) {
+        return;
+    }
+
+    m_settings.setValue(BACKGROUND_BACKUP_INTERVAL_KEY, minutes);
+    emit backgroundBackupIntervalChanged();
+}
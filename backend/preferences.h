@@ -9,6 +9,8 @@ class Preferences : public QObject
     Q_PROPERTY(QString updateChannel READ firmwareUpdateChannel WRITE setFirmwareUpdateChannel NOTIFY firmwareUpdateChannelChanged)
     Q_PROPERTY(QString appUpdateChannel READ applicationUpdateChannel WRITE setApplicationUpdateChannel NOTIFY applicationUpdateChannelChanged)
     Q_PROPERTY(bool checkAppUpdates READ checkApplicationUpdates WRITE setCheckApplicationUpdates NOTIFY checkApplicationUpdatesChanged)
+    Q_PROPERTY(QString backgroundBackupPath READ backgroundBackupPath WRITE setBackgroundBackupPath NOTIFY backgroundBackupPathChanged)
+    Q_PROPERTY(int backgroundBackupInterval READ backgroundBackupInterval WRITE setBackgroundBackupInterval NOTIFY backgroundBackupIntervalChanged)
 
     Preferences(QObject *parent = nullptr);
 
@@ -24,10 +26,19 @@ public:
     bool checkApplicationUpdates() const;
     void setCheckApplicationUpdates(bool set);
 
+    const QString backgroundBackupPath() const;
+    void setBackgroundBackupPath(const QString &newPath);
+
+    // In minutes, 0 - disabled
+    int backgroundBackupInterval() const;
+    void setBackgroundBackupInterval(int minutes);
+
 signals:
     void firmwareUpdateChannelChanged();
     void applicationUpdateChannelChanged();
     void checkApplicationUpdatesChanged();
+    void backgroundBackupPathChanged();
+    void backgroundBackupIntervalChanged();
 
 private:
     QSettings m_settings;
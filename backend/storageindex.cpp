@@ -0,0 +1,358 @@
+#include "storageindex.h"
+
+#include <QSet>
+#include <QRegularExpression>
+
+#include <algorithm>
+
+static QString escapeSet(const QByteArray &set)
+{
+    QString ret;
+    auto i = 0;
+
+    if(set.startsWith('!')) {
+        ret.append(QLatin1Char('^'));
+        ++i;
+    }
+
+    for(const auto c : QString::fromUtf8(set.mid(i))) {
+        if(c == QLatin1Char('\\') || c == QLatin1Char('^') || c == QLatin1Char('[')) {
+            ret.append(QLatin1Char('\\'));
+        }
+
+        ret.append(c);
+    }
+
+    return ret;
+}
+
+static QString globToRegularExpression(const QByteArray &glob)
+{
+    QString ret;
+    QByteArray literal;
+
+    // Literal bytes are collected into runs, so that multibyte UTF-8 sequences are decoded whole
+    const auto flushLiteral = [&]() {
+        if(!literal.isEmpty()) {
+            ret.append(QRegularExpression::escape(QString::fromUtf8(literal)));
+            literal.clear();
+        }
+    };
+
+    for(auto i = 0; i < glob.size(); ++i) {
+        const auto c = glob.at(i);
+
+        if(c == '*') {
+            flushLiteral();
+            ret.append(QStringLiteral(".*"));
+
+        } else if(c == '?') {
+            flushLiteral();
+            ret.append(QLatin1Char('.'));
+
+        } else if(c == '[') {
+            const auto end = glob.indexOf(']', i + 1);
+
+            if(end < 0) {
+                literal.append(c);
+                continue;
+            }
+
+            flushLiteral();
+            ret.append(QStringLiteral("[%1]").arg(escapeSet(glob.mid(i + 1, end - i - 1))));
+            i = end;
+
+        } else {
+            literal.append(c);
+        }
+    }
+
+    flushLiteral();
+
+    return QRegularExpression::anchoredPattern(ret);
+}
+
+StorageIndex::StorageIndex()
+{}
+
+int StorageIndex::size() const
+{
+    return m_ids.size();
+}
+
+bool StorageIndex::isEmpty() const
+{
+    return m_ids.isEmpty();
+}
+
+void StorageIndex::clear()
+{
+    m_entries.clear();
+    m_freeIds.clear();
+    m_ids.clear();
+    m_postings.clear();
+}
+
+bool StorageIndex::insert(const FileInfo &fileInfo)
+{
+    const auto it = m_ids.constFind(fileInfo.absolutePath);
+
+    if(it != m_ids.constEnd()) {
+        // Path is already indexed, only its metadata may have changed
+        m_entries[it.value()].fileInfo = fileInfo;
+        return false;
+    }
+
+    EntryId id;
+    const auto key = toKey(fileInfo.absolutePath);
+
+    if(m_freeIds.isEmpty()) {
+        id = m_entries.size();
+        m_entries.append({fileInfo, key, true});
+    } else {
+        id = m_freeIds.takeLast();
+        m_entries[id] = {fileInfo, key, true};
+    }
+
+    m_ids.insert(fileInfo.absolutePath, id);
+
+    for(const auto trigram : trigrams(key)) {
+        auto &postings = m_postings[trigram];
+
+        // Keep the posting lists sorted, appending is the common case
+        if(postings.isEmpty() || postings.last() < id) {
+            postings.append(id);
+        } else {
+            postings.insert(std::lower_bound(postings.begin(), postings.end(), id), id);
+        }
+    }
+
+    return true;
+}
+
+bool StorageIndex::remove(const QByteArray &absolutePath)
+{
+    const auto it = m_ids.find(absolutePath);
+
+    if(it == m_ids.end()) {
+        return false;
+    }
+
+    const auto id = it.value();
+    auto &entry = m_entries[id];
+
+    for(const auto trigram : trigrams(entry.key)) {
+        auto postingsIt = m_postings.find(trigram);
+
+        if(postingsIt == m_postings.end()) {
+            continue;
+        }
+
+        auto &postings = postingsIt.value();
+        const auto pos = std::lower_bound(postings.begin(), postings.end(), id);
+
+        if(pos != postings.end() && *pos == id) {
+            postings.erase(pos);
+        }
+
+        if(postings.isEmpty()) {
+            m_postings.erase(postingsIt);
+        }
+    }
+
+    entry = {FileInfo(), QByteArray(), false};
+
+    m_ids.erase(it);
+    m_freeIds.append(id);
+
+    return true;
+}
+
+void StorageIndex::update(const FileInfoList &files)
+{
+    QSet<QByteArray> paths;
+    paths.reserve(files.size());
+
+    for(const auto &fileInfo : files) {
+        paths.insert(fileInfo.absolutePath);
+    }
+
+    const auto indexedPaths = m_ids.keys();
+
+    for(const auto &path : indexedPaths) {
+        if(!paths.contains(path)) {
+            remove(path);
+        }
+    }
+
+    for(const auto &fileInfo : files) {
+        insert(fileInfo);
+    }
+}
+
+FileInfoList StorageIndex::find(const QByteArray &pattern, int maxResults) const
+{
+    FileInfoList ret;
+
+    if(pattern.isEmpty()) {
+        return ret;
+    }
+
+    const auto key = toKey(pattern);
+    const auto isGlob = isGlobPattern(key);
+
+    QRegularExpression re;
+
+    if(isGlob) {
+        re.setPattern(globToRegularExpression(key));
+
+        if(!re.isValid()) {
+            return ret;
+        }
+    }
+
+    const auto ids = candidates(isGlob ? literals(key) : QList<QByteArray>({key}));
+
+    for(const auto id : ids) {
+        const auto &entry = m_entries.at(id);
+
+        if(!entry.isValid) {
+            continue;
+        }
+
+        const auto isMatch = isGlob ? re.match(QString::fromUtf8(entry.key)).hasMatch() : entry.key.contains(key);
+
+        if(isMatch) {
+            ret.append(entry.fileInfo);
+        }
+    }
+
+    std::sort(ret.begin(), ret.end(), [](const FileInfo &a, const FileInfo &b) {
+        return a.absolutePath < b.absolutePath;
+    });
+
+    if(maxResults >= 0 && ret.size() > maxResults) {
+        ret.erase(ret.begin() + maxResults, ret.end());
+    }
+
+    return ret;
+}
+
+bool StorageIndex::isGlobPattern(const QByteArray &pattern)
+{
+    return pattern.contains('*') || pattern.contains('?') || pattern.contains('[');
+}
+
+QByteArray StorageIndex::toKey(const QByteArray &path)
+{
+    // ASCII only, UTF-8 multibyte sequences are left intact
+    auto ret = path;
+
+    for(auto &c : ret) {
+        if(c >= 'A' && c <= 'Z') {
+            c += 'a' - 'A';
+        }
+    }
+
+    return ret;
+}
+
+QVector<StorageIndex::Trigram> StorageIndex::trigrams(const QByteArray &key)
+{
+    QVector<Trigram> ret;
+
+    if(key.size() < 3) {
+        return ret;
+    }
+
+    ret.reserve(key.size() - 2);
+
+    const auto *data = (const uchar*)key.constData();
+
+    for(auto i = 0; i < key.size() - 2; ++i) {
+        ret.append(((Trigram)data[i] << 16) | ((Trigram)data[i + 1] << 8) | data[i + 2]);
+    }
+
+    std::sort(ret.begin(), ret.end());
+    ret.erase(std::unique(ret.begin(), ret.end()), ret.end());
+
+    return ret;
+}
+
+QList<QByteArray> StorageIndex::literals(const QByteArray &pattern)
+{
+    QList<QByteArray> ret;
+    QByteArray current;
+
+    for(auto i = 0; i < pattern.size(); ++i) {
+        const auto c = pattern.at(i);
+
+        if(c == '*' || c == '?' || c == '[') {
+            if(!current.isEmpty()) {
+                ret.append(current);
+                current.clear();
+            }
+
+            if(c == '[') {
+                const auto end = pattern.indexOf(']', i + 1);
+                i = (end < 0) ? pattern.size() : end;
+            }
+
+        } else {
+            current.append(c);
+        }
+    }
+
+    if(!current.isEmpty()) {
+        ret.append(current);
+    }
+
+    return ret;
+}
+
+StorageIndex::PostingList StorageIndex::candidates(const QList<QByteArray> &literals) const
+{
+    QVector<const PostingList*> lists;
+
+    for(const auto &literal : literals) {
+        for(const auto trigram : trigrams(literal)) {
+            const auto it = m_postings.constFind(trigram);
+
+            if(it == m_postings.constEnd()) {
+                return PostingList();
+            }
+
+            lists.append(&it.value());
+        }
+    }
+
+    PostingList ret;
+
+    if(lists.isEmpty()) {
+        // Pattern is too short to use the index, fall back to a full scan
+        ret.reserve(m_ids.size());
+
+        for(const auto id : m_ids) {
+            ret.append(id);
+        }
+
+        return ret;
+    }
+
+    // Start with the rarest trigram to keep the intermediate results small
+    std::sort(lists.begin(), lists.end(), [](const PostingList *a, const PostingList *b) {
+        return a->size() < b->size();
+    });
+
+    ret = *lists.first();
+
+    for(auto i = 1; i < lists.size() && !ret.isEmpty(); ++i) {
+        PostingList intersection;
+        intersection.reserve(ret.size());
+
+        std::set_intersection(ret.cbegin(), ret.cend(), lists.at(i)->cbegin(), lists.at(i)->cend(), std::back_inserter(intersection));
+        ret.swap(intersection);
+    }
+
+    return ret;
+}
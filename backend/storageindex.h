@@ -0,0 +1,54 @@
+#pragma once
+
+#include <QHash>
+#include <QVector>
+#include <QByteArray>
+
+#include "fileinfo.h"
+
+/* Trigram index over absolute device paths.
+ * Matching is ASCII case-insensitive, as are the FAT filesystems on the device. */
+
+class StorageIndex
+{
+    using EntryId = int;
+    using Trigram = quint32;
+    using PostingList = QVector<EntryId>;
+
+    struct Entry {
+        FileInfo fileInfo;
+        QByteArray key;
+        bool isValid;
+    };
+
+public:
+    StorageIndex();
+
+    int size() const;
+    bool isEmpty() const;
+    void clear();
+
+    bool insert(const FileInfo &fileInfo);
+    bool remove(const QByteArray &absolutePath);
+
+    // Applies the difference between the current contents and the new list
+    void update(const FileInfoList &files);
+
+    // Patterns containing *, ? or [] are treated as globs matching the whole path,
+    // anything else is a plain substring search
+    FileInfoList find(const QByteArray &pattern, int maxResults = -1) const;
+
+    static bool isGlobPattern(const QByteArray &pattern);
+
+private:
+    static QByteArray toKey(const QByteArray &path);
+    static QVector<Trigram> trigrams(const QByteArray &key);
+    static QList<QByteArray> literals(const QByteArray &pattern);
+
+    PostingList candidates(const QList<QByteArray> &literals) const;
+
+    QVector<Entry> m_entries;
+    QVector<EntryId> m_freeIds;
+    QHash<QByteArray, EntryId> m_ids;
+    QHash<Trigram, PostingList> m_postings;
+};
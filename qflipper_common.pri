@@ -25,6 +25,11 @@ unix:!macx {
     error("Unsupported OS or compiler")
 }
 
+# Build with `qmake CONFIG+=alloc_accounting` to get per-operation heap statistics on exit
+alloc_accounting {
+    DEFINES += ALLOCATION_ACCOUNTING
+}
+
 GIT_VERSION = $$system("git describe --tags --abbrev=0","lines", HAS_VERSION)
 !equals(HAS_VERSION, 0) {
     GIT_VERSION = unknown
@@ -1,6 +1,8 @@
 #include "tool.h"
 
 #include <QDebug>
+#include <QTimer>
+#include <QTextStream>
 #include <QLoggingCategory>
 
 #include "logger.h"
@@ -14,6 +16,7 @@ Q_LOGGING_CATEGORY(LOG_TOOL, "TOOL")
 Tool::Tool(int argc, char *argv[]):
     QCoreApplication(argc, argv),
     m_pendingOperation(NoOperation),
+    m_backupInterval(0),
     m_repeatCount(1)
 {
     initConnections();
@@ -80,9 +83,66 @@ void Tool::onUpdateStateChanged()
     }
 }
 
+void Tool::onStorageIndexUpdated(bool success)
+{
+    if(!success) {
+        qCCritical(LOG_TOOL) << "Failed to index device storage. Exiting.";
+        return exit(-1);
+    }
+
+    const auto files = m_backend.findFiles(m_searchPattern, -1);
+
+    QTextStream out(stdout);
+    for(const auto &file : files) {
+        out << file << Qt::endl;
+    }
+
+    qCInfo(LOG_TOOL).nospace() << "Found " << files.size() << " matching entries.";
+    startPendingOperation();
+}
+
+void Tool::onBundleCompiled(bool success)
+{
+    if(!success) {
+        qCCritical(LOG_TOOL) << "Failed to compile the bundle. Exiting.";
+        return exit(-1);
+    }
+
+    qCInfo(LOG_TOOL).noquote() << "Bundle saved to" << m_targetParameter.toLocalFile();
+    startPendingOperation();
+}
+
+void Tool::onDeviceEtaChanged()
+{
+    static constexpr qint64 ETA_REPORT_INTERVAL_MS = 10000;
+
+    const auto eta = qRound(m_backend.deviceState()->eta());
+
+    if(eta < 0 || (m_etaTimer.isValid() && !m_etaTimer.hasExpired(ETA_REPORT_INTERVAL_MS))) {
+        return;
+    }
+
+    qCInfo(LOG_TOOL).noquote() << QStringLiteral("Estimated time remaining: %1:%2").arg(eta / 60).arg(eta % 60, 2, 10, QLatin1Char('0'));
+    m_etaTimer.start();
+}
+
+void Tool::onBackgroundBackupFinished(const QString &summaryFile)
+{
+    qCInfo(LOG_TOOL).noquote() << "Background backup finished, see" << summaryFile;
+
+    if(m_repeatCount == 0) {
+        startPendingOperation();
+    } else {
+        QTimer::singleShot(m_backupInterval * 60 * 1000, this, &Tool::startPendingOperation);
+    }
+}
+
 void Tool::initConnections()
 {
     connect(&m_backend, &ApplicationBackend::backendStateChanged, this, &Tool::onBackendStateChanged);
+    connect(&m_backend, &ApplicationBackend::storageIndexUpdated, this, &Tool::onStorageIndexUpdated);
+    connect(&m_backend, &ApplicationBackend::bundleCompiled, this, &Tool::onBundleCompiled);
+    connect(&m_backend, &ApplicationBackend::backgroundBackupFinished, this, &Tool::onBackgroundBackupFinished);
 }
 
 void Tool::initLogger()
@@ -99,7 +159,11 @@ void Tool::initParser()
     m_parser.addPositionalArgument(QStringLiteral("wipe"), QStringLiteral("Wipe entire MCU Flash Memory"), QStringLiteral("wipe,"));
     m_parser.addPositionalArgument(QStringLiteral("firmware"), QStringLiteral("Flash Core1 Firmware"), QStringLiteral("firmware <firmware_file.dfu>,"));
     m_parser.addPositionalArgument(QStringLiteral("core2radio"), QStringLiteral("Flash Core2 Radio stack"), QStringLiteral("core2radio <firmware_file.bin>,"));
-    m_parser.addPositionalArgument(QStringLiteral("core2fus"), QStringLiteral("Flash Core2 Firmware Update Service"), QStringLiteral("core2fus <firmware_file.bin> <target_address>}"));
+    m_parser.addPositionalArgument(QStringLiteral("core2fus"), QStringLiteral("Flash Core2 Firmware Update Service"), QStringLiteral("core2fus <firmware_file.bin> <target_address>,"));
+    m_parser.addPositionalArgument(QStringLiteral("provision"), QStringLiteral("Write a directory or a pre-compiled bundle to External Memory"), QStringLiteral("provision <source_directory|bundle_file>,"));
+    m_parser.addPositionalArgument(QStringLiteral("bundle"), QStringLiteral("Pre-encode a directory into a bundle file for the connected device's protocol version"), QStringLiteral("bundle <source_directory> <bundle_file>,"));
+    m_parser.addPositionalArgument(QStringLiteral("find"), QStringLiteral("Find files on the device by substring or glob pattern"), QStringLiteral("find <pattern>,"));
+    m_parser.addPositionalArgument(QStringLiteral("autobackup"), QStringLiteral("Periodically backup Internal Memory of all connected devices"), QStringLiteral("autobackup <target_directory> <interval_minutes>}"));
 
     m_options.append(QCommandLineOption({QStringLiteral("d"), QStringLiteral("debug-level")}, QStringLiteral("0 - Errors Only, 1 - Terse, 2 - Full"), QStringLiteral("1")));
     m_options.append(QCommandLineOption({QStringLiteral("n"), QStringLiteral("repeat-number")}, QStringLiteral("Number of times to repeat the operation, 0 - indefinitely"), QStringLiteral("1")));
@@ -141,6 +205,14 @@ void Tool::processArguments()
         beginCore2Radio();
     } else if(args.startsWith(QStringLiteral("core2fus"))) {
         beginCore2FUS();
+    } else if(args.startsWith(QStringLiteral("provision"))) {
+        beginProvision();
+    } else if(args.startsWith(QStringLiteral("bundle"))) {
+        beginCompileBundle();
+    } else if(args.startsWith(QStringLiteral("find"))) {
+        beginFind();
+    } else if(args.startsWith(QStringLiteral("autobackup"))) {
+        beginAutoBackup();
     } else {
         m_parser.showHelp(-1);
     }
@@ -305,6 +377,55 @@ void Tool::beginCore2FUS()
     m_pendingOperation = Core2FUS;
 }
 
+void Tool::beginProvision()
+{
+    verifyArgumentCount(2);
+    m_fileParameter = QUrl::fromLocalFile(m_parser.positionalArguments().at(1));
+
+    qCInfo(LOG_TOOL).noquote().nospace() << "Performing external storage provisioning from " << m_fileParameter << "...";
+    m_pendingOperation = Provision;
+}
+
+void Tool::beginCompileBundle()
+{
+    verifyArgumentCount(3);
+
+    const auto args = m_parser.positionalArguments();
+    m_fileParameter = QUrl::fromLocalFile(args.at(1));
+    m_targetParameter = QUrl::fromLocalFile(args.at(2));
+
+    qCInfo(LOG_TOOL).noquote().nospace() << "Compiling " << m_fileParameter << " into a bundle...";
+    m_pendingOperation = CompileBundle;
+}
+
+void Tool::beginFind()
+{
+    verifyArgumentCount(2);
+    m_searchPattern = m_parser.positionalArguments().at(1);
+
+    qCInfo(LOG_TOOL).noquote().nospace() << "Searching device storage for " << m_searchPattern << "...";
+    m_pendingOperation = Find;
+}
+
+void Tool::beginAutoBackup()
+{
+    verifyArgumentCount(3);
+
+    const auto args = m_parser.positionalArguments();
+    m_fileParameter = QUrl::fromLocalFile(args.at(1));
+
+    bool canConvert;
+    m_backupInterval = args.at(2).toInt(&canConvert);
+
+    if(!canConvert || m_backupInterval <= 0) {
+        qCCritical(LOG_TOOL) << "Backup interval must be a positive number of minutes.";
+        std::exit(-1);
+    }
+
+    qCInfo(LOG_TOOL).noquote().nospace() << "Performing background backups to " << m_fileParameter << " every " << m_backupInterval << " minute(s)...";
+    m_pendingOperation = AutoBackup;
+}
+
 void Tool::startPendingOperation()
 {
     if(m_repeatCount == 0) {
@@ -315,6 +436,11 @@ void Tool::startPendingOperation()
         --m_repeatCount;
     }
 
+    if(m_backend.deviceState()) {
+        connect(m_backend.deviceState(), &Flipper::Zero::DeviceState::etaChanged, this, &Tool::onDeviceEtaChanged, Qt::UniqueConnection);
+        m_etaTimer.invalidate();
+    }
+
     if(m_pendingOperation == DefaultAction) {
         m_backend.mainAction();
 
@@ -332,6 +458,15 @@ void Tool::startPendingOperation()
         m_backend.installWirelessStack(m_fileParameter);
     } else if(m_pendingOperation == Core2FUS) {
         m_backend.installFUS(m_fileParameter, m_core2Address);
+    } else if(m_pendingOperation == Provision) {
+        m_backend.provisionStorage(m_fileParameter);
+    } else if(m_pendingOperation == CompileBundle) {
+        m_backend.compileBundle(m_fileParameter, m_targetParameter);
+    } else if(m_pendingOperation == Find) {
+        // The index is updated incrementally, so repeated searches only transfer the file tree
+        m_backend.refreshStorageIndex();
+    } else if(m_pendingOperation == AutoBackup) {
+        m_backend.runBackgroundBackup(m_fileParameter);
     } else {
         qCCritical(LOG_TOOL) << "Unhandled operation. Probably a bug!";
         exit(-1);
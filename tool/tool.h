@@ -1,6 +1,7 @@
 #pragma once
 
 #include <QUrl>
+#include <QElapsedTimer>
 #include <QCoreApplication>
 #include <QCommandLineParser>
 
@@ -19,7 +20,11 @@ class Tool : public QCoreApplication
         Wipe,
         Firmware,
         Core2Radio,
-        Core2FUS
+        Core2FUS,
+        Provision,
+        CompileBundle,
+        Find,
+        AutoBackup
     };
 
     enum OptionIndex {
@@ -35,6 +40,10 @@ public:
 private slots:
     void onBackendStateChanged();
     void onUpdateStateChanged();
+    void onStorageIndexUpdated(bool success);
+    void onBundleCompiled(bool success);
+    void onDeviceEtaChanged();
+    void onBackgroundBackupFinished(const QString &summaryFile);
 
 private:
     void initConnections();
@@ -56,6 +65,10 @@ private:
     void beginFirmware();
     void beginCore2Radio();
     void beginCore2FUS();
+    void beginProvision();
+    void beginCompileBundle();
+    void beginFind();
+    void beginAutoBackup();
 
     void startPendingOperation();
     void verifyArgumentCount(int num);
@@ -65,7 +78,11 @@ private:
     ApplicationBackend m_backend;
     OperationType m_pendingOperation;
     QUrl m_fileParameter;
+    QUrl m_targetParameter;
+    QString m_searchPattern;
     uint32_t m_core2Address;
+    int m_backupInterval;
     int m_repeatCount;
+    QElapsedTimer m_etaTimer;
 };
 